@@ -65,7 +65,8 @@ public:
     Course* getCourse(int);
     int getCourseByCode(const std::string&) const;
     int count() const;
-    void listAll() const;
+    // Rows firstRow.. (maxRows < 0: to the end)
+    void listAll(int firstRow = 0, int maxRows = -1) const;
     const std::vector<Course>& getAllCourses() const;
 };
 
@@ -1,4 +1,5 @@
 #include "CourseManager.h"
+#include "ReportWriter.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -165,18 +166,19 @@ int CourseManager::getCourseByCode(const std::string& code) const {
 
 int CourseManager::count() const { return courses.size(); }
 
-void CourseManager::listAll() const {
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << "  ALL COURSES\n";
-    std::cout << std::string(60, '=') << "\n\n";
-    std::cout << std::left << std::setw(5) << "ID" << std::setw(12) << "Code"
-        << std::setw(25) << "Name" << "Credits\n";
-    std::cout << std::string(60, '-') << "\n";
+void CourseManager::listAll(int firstRow, int maxRows) const {
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text("  ALL COURSES").newline().repeat('=', 60).newline().newline();
+    w.left("ID", 5).left("Code", 12).left("Name", 25).text("Credits").newline();
+    w.repeat('-', 60).newline();
+    int row = 0, shown = 0;
     for (const auto& c : courses) {
-        std::cout << std::left << std::setw(5) << c.id << std::setw(12) << c.code
-            << std::setw(25) << c.name << c.credits << "\n";
+        if (row++ < firstRow || (maxRows >= 0 && shown >= maxRows)) continue;
+        shown++;
+        w.left(c.id, 5).left(c.code, 12).left(c.name, 25).number(c.credits).newline();
     }
-    std::cout << "\nTotal Courses: " << courses.size() << "\n";
+    w.showing(firstRow, shown, row);
+    w.newline().text("Total Courses: ").number((long long)courses.size()).newline();
 }
 
 const std::vector<CourseManager::Course>& CourseManager::getAllCourses() const {
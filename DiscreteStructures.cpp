@@ -1,6 +1,12 @@
 #include "DiscreteStructures.h"
 #include <iostream>
 #include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 // ============================================================================
 // CUSTOMSET TEMPLATE IMPLEMENTATIONS
@@ -67,6 +73,431 @@ CustomSet<T> CustomSet<T>::setUnion(const CustomSet<T>& other) const {
     return result;
 }
 
+// ============================================================================
+// COMPRESSED BITMAP SET IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const int CHUNK_WORDS = 1024;          // 65536 bits per bitmap container
+const int ARRAY_MAX_CARDINALITY = 4096; // above this a bitmap is smaller than an array
+
+inline int popcount64(unsigned long long x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(x));
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline int lowestBit(unsigned long long x) {
+    return popcount64((x & (~x + 1)) - 1);
+}
+
+inline unsigned int toUnsigned(int val) {
+    // Flip the sign bit so negative IDs sort before positive ones
+    return static_cast<unsigned int>(val) ^ 0x80000000u;
+}
+
+inline int fromUnsigned(unsigned int u) {
+    return static_cast<int>(u ^ 0x80000000u);
+}
+
+int countRunsInBitmap(const std::vector<unsigned long long>& words) {
+    int runs = 0;
+    for (int i = 0; i < CHUNK_WORDS; i++) {
+        unsigned long long w = words[i];
+        unsigned long long next = (i + 1 < CHUNK_WORDS) ? words[i + 1] : 0ULL;
+        // A run ends at every 1 bit followed by a 0 bit
+        runs += popcount64(w & ~((w >> 1) | (next << 63)));
+    }
+    return runs;
+}
+
+int countRunsInArray(const std::vector<unsigned short>& values) {
+    int runs = values.empty() ? 0 : 1;
+    for (size_t i = 1; i < values.size(); i++) {
+        if (values[i] != values[i - 1] + 1) runs++;
+    }
+    return runs;
+}
+
+} // namespace
+
+CustomSet<int>::CustomSet() : total(0), cacheValid(true) {}
+
+int CustomSet<int>::findContainer(unsigned short key) const {
+    int lo = 0, hi = static_cast<int>(containers.size()) - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (containers[mid].key == key) return mid;
+        if (containers[mid].key < key) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -(lo + 1);
+}
+
+bool CustomSet<int>::containerContains(const Container& c, unsigned short low) {
+    if (c.type == ARRAY_CONTAINER) {
+        return std::binary_search(c.values.begin(), c.values.end(), low);
+    }
+    if (c.type == BITMAP_CONTAINER) {
+        return (c.words[low >> 6] >> (low & 63)) & 1ULL;
+    }
+    int lo = 0, hi = static_cast<int>(c.values.size() / 2) - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        unsigned short start = c.values[2 * mid];
+        if (low < start) hi = mid - 1;
+        else if (low > start + c.values[2 * mid + 1]) lo = mid + 1;
+        else return true;
+    }
+    return false;
+}
+
+void CustomSet<int>::toArray(Container& c) {
+    if (c.type == ARRAY_CONTAINER) return;
+    std::vector<unsigned short> out;
+    out.reserve(c.cardinality);
+    if (c.type == BITMAP_CONTAINER) {
+        for (int i = 0; i < CHUNK_WORDS; i++) {
+            unsigned long long w = c.words[i];
+            while (w) {
+                out.push_back(static_cast<unsigned short>(i * 64 + lowestBit(w)));
+                w &= w - 1;
+            }
+        }
+    } else {
+        for (size_t r = 0; r + 1 < c.values.size(); r += 2) {
+            int start = c.values[r];
+            int end = start + c.values[r + 1];
+            for (int v = start; v <= end; v++) out.push_back(static_cast<unsigned short>(v));
+        }
+    }
+    c.values.swap(out);
+    c.words.clear();
+    c.words.shrink_to_fit();
+    c.type = ARRAY_CONTAINER;
+}
+
+void CustomSet<int>::toBitmap(Container& c) {
+    if (c.type == BITMAP_CONTAINER) return;
+    c.words.assign(CHUNK_WORDS, 0ULL);
+    if (c.type == ARRAY_CONTAINER) {
+        for (unsigned short v : c.values) c.words[v >> 6] |= 1ULL << (v & 63);
+    } else {
+        for (size_t r = 0; r + 1 < c.values.size(); r += 2) {
+            int start = c.values[r];
+            int end = start + c.values[r + 1];
+            for (int v = start; v <= end; v++) c.words[v >> 6] |= 1ULL << (v & 63);
+        }
+    }
+    c.values.clear();
+    c.values.shrink_to_fit();
+    c.type = BITMAP_CONTAINER;
+}
+
+void CustomSet<int>::expandRuns(Container& c) {
+    if (c.type != RUN_CONTAINER) return;
+    if (c.cardinality > ARRAY_MAX_CARDINALITY) toBitmap(c);
+    else toArray(c);
+}
+
+CustomSet<int>::Container CustomSet<int>::combine(const Container& a, const Container& b, SetOp op) {
+    Container x = a, y = b;
+    expandRuns(x);
+    expandRuns(y);
+
+    Container result;
+    result.key = a.key;
+
+    if (x.type == ARRAY_CONTAINER && y.type == ARRAY_CONTAINER) {
+        result.type = ARRAY_CONTAINER;
+        std::vector<unsigned short>& out = result.values;
+        if (op == OP_AND)
+            std::set_intersection(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(), std::back_inserter(out));
+        else if (op == OP_OR)
+            std::set_union(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(), std::back_inserter(out));
+        else if (op == OP_ANDNOT)
+            std::set_difference(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(), std::back_inserter(out));
+        else
+            std::set_symmetric_difference(x.values.begin(), x.values.end(), y.values.begin(), y.values.end(), std::back_inserter(out));
+        result.cardinality = static_cast<int>(out.size());
+        if (result.cardinality > ARRAY_MAX_CARDINALITY) toBitmap(result);
+        return result;
+    }
+
+    // Filtering a sparse side against a bitmap avoids touching all 1024 words
+    if ((op == OP_AND || op == OP_ANDNOT) && x.type == ARRAY_CONTAINER) {
+        result.type = ARRAY_CONTAINER;
+        bool keepIfPresent = (op == OP_AND);
+        for (unsigned short v : x.values) {
+            if (containerContains(y, v) == keepIfPresent) result.values.push_back(v);
+        }
+        result.cardinality = static_cast<int>(result.values.size());
+        return result;
+    }
+    if (op == OP_AND && y.type == ARRAY_CONTAINER) {
+        return combine(b, a, op);
+    }
+
+    toBitmap(x);
+    toBitmap(y);
+    result.type = BITMAP_CONTAINER;
+    result.words.resize(CHUNK_WORDS);
+    const unsigned long long* wx = x.words.data();
+    const unsigned long long* wy = y.words.data();
+    unsigned long long* out = result.words.data();
+    // Straight-line word loops so the compiler can vectorise them
+    switch (op) {
+    case OP_AND:    for (int i = 0; i < CHUNK_WORDS; i++) out[i] = wx[i] & wy[i]; break;
+    case OP_OR:     for (int i = 0; i < CHUNK_WORDS; i++) out[i] = wx[i] | wy[i]; break;
+    case OP_ANDNOT: for (int i = 0; i < CHUNK_WORDS; i++) out[i] = wx[i] & ~wy[i]; break;
+    case OP_XOR:    for (int i = 0; i < CHUNK_WORDS; i++) out[i] = wx[i] ^ wy[i]; break;
+    }
+    int card = 0;
+    for (int i = 0; i < CHUNK_WORDS; i++) card += popcount64(out[i]);
+    result.cardinality = card;
+    if (card <= ARRAY_MAX_CARDINALITY) toArray(result);
+    return result;
+}
+
+int CustomSet<int>::andCardinality(const Container& a, const Container& b) {
+    if (a.type == RUN_CONTAINER || b.type == RUN_CONTAINER) {
+        return combine(a, b, OP_AND).cardinality;
+    }
+    if (a.type == ARRAY_CONTAINER && b.type == ARRAY_CONTAINER) {
+        int count = 0;
+        size_t i = 0, j = 0;
+        while (i < a.values.size() && j < b.values.size()) {
+            if (a.values[i] < b.values[j]) i++;
+            else if (a.values[i] > b.values[j]) j++;
+            else { count++; i++; j++; }
+        }
+        return count;
+    }
+    if (a.type == ARRAY_CONTAINER || b.type == ARRAY_CONTAINER) {
+        const Container& arr = (a.type == ARRAY_CONTAINER) ? a : b;
+        const Container& bmp = (a.type == ARRAY_CONTAINER) ? b : a;
+        int count = 0;
+        for (unsigned short v : arr.values) {
+            if ((bmp.words[v >> 6] >> (v & 63)) & 1ULL) count++;
+        }
+        return count;
+    }
+    int count = 0;
+    for (int i = 0; i < CHUNK_WORDS; i++) count += popcount64(a.words[i] & b.words[i]);
+    return count;
+}
+
+CustomSet<int> CustomSet<int>::merge(const CustomSet<int>& other, SetOp op) const {
+    CustomSet<int> result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        bool haveA = i < containers.size();
+        bool haveB = j < other.containers.size();
+        if (haveA && (!haveB || containers[i].key < other.containers[j].key)) {
+            if (op != OP_AND) result.containers.push_back(containers[i]);
+            i++;
+        }
+        else if (haveB && (!haveA || other.containers[j].key < containers[i].key)) {
+            if (op == OP_OR || op == OP_XOR) result.containers.push_back(other.containers[j]);
+            j++;
+        }
+        else {
+            Container c = combine(containers[i], other.containers[j], op);
+            if (c.cardinality > 0) result.containers.push_back(c);
+            i++;
+            j++;
+        }
+    }
+    for (const auto& c : result.containers) result.total += c.cardinality;
+    result.cacheValid = false;
+    return result;
+}
+
+const std::vector<int>& CustomSet<int>::materialize() const {
+    if (cacheValid) return cache;
+    cache.clear();
+    cache.reserve(total);
+    for (const auto& c : containers) {
+        unsigned int high = static_cast<unsigned int>(c.key) << 16;
+        if (c.type == ARRAY_CONTAINER) {
+            for (unsigned short v : c.values) cache.push_back(fromUnsigned(high | v));
+        }
+        else if (c.type == BITMAP_CONTAINER) {
+            for (int w = 0; w < CHUNK_WORDS; w++) {
+                unsigned long long bits = c.words[w];
+                while (bits) {
+                    cache.push_back(fromUnsigned(high | static_cast<unsigned int>(w * 64 + lowestBit(bits))));
+                    bits &= bits - 1;
+                }
+            }
+        }
+        else {
+            for (size_t r = 0; r + 1 < c.values.size(); r += 2) {
+                unsigned int start = c.values[r];
+                unsigned int end = start + c.values[r + 1];
+                for (unsigned int v = start; v <= end; v++) cache.push_back(fromUnsigned(high | v));
+            }
+        }
+    }
+    cacheValid = true;
+    return cache;
+}
+
+void CustomSet<int>::insert(const int& val) {
+    unsigned int u = toUnsigned(val);
+    unsigned short key = static_cast<unsigned short>(u >> 16);
+    unsigned short low = static_cast<unsigned short>(u & 0xFFFF);
+
+    int idx = findContainer(key);
+    if (idx < 0) {
+        Container c;
+        c.key = key;
+        c.type = ARRAY_CONTAINER;
+        c.cardinality = 1;
+        c.values.push_back(low);
+        containers.insert(containers.begin() + (-idx - 1), c);
+        total++;
+        cacheValid = false;
+        return;
+    }
+
+    Container& c = containers[idx];
+    if (containerContains(c, low)) return;
+    expandRuns(c);
+    if (c.type == ARRAY_CONTAINER) {
+        if (c.cardinality >= ARRAY_MAX_CARDINALITY) {
+            toBitmap(c);
+        }
+        else {
+            c.values.insert(std::lower_bound(c.values.begin(), c.values.end(), low), low);
+        }
+    }
+    if (c.type == BITMAP_CONTAINER) {
+        c.words[low >> 6] |= 1ULL << (low & 63);
+    }
+    c.cardinality++;
+    total++;
+    cacheValid = false;
+}
+
+bool CustomSet<int>::contains(const int& val) const {
+    unsigned int u = toUnsigned(val);
+    int idx = findContainer(static_cast<unsigned short>(u >> 16));
+    if (idx < 0) return false;
+    return containerContains(containers[idx], static_cast<unsigned short>(u & 0xFFFF));
+}
+
+void CustomSet<int>::erase(const int& val) {
+    unsigned int u = toUnsigned(val);
+    unsigned short low = static_cast<unsigned short>(u & 0xFFFF);
+    int idx = findContainer(static_cast<unsigned short>(u >> 16));
+    if (idx < 0 || !containerContains(containers[idx], low)) return;
+
+    Container& c = containers[idx];
+    expandRuns(c);
+    if (c.type == ARRAY_CONTAINER) {
+        c.values.erase(std::lower_bound(c.values.begin(), c.values.end(), low));
+    }
+    else {
+        c.words[low >> 6] &= ~(1ULL << (low & 63));
+    }
+    c.cardinality--;
+    total--;
+    if (c.cardinality == 0) {
+        containers.erase(containers.begin() + idx);
+    }
+    else if (c.type == BITMAP_CONTAINER && c.cardinality <= ARRAY_MAX_CARDINALITY) {
+        toArray(c);
+    }
+    cacheValid = false;
+}
+
+int CustomSet<int>::size() const { return total; }
+
+bool CustomSet<int>::empty() const { return total == 0; }
+
+void CustomSet<int>::clear() {
+    containers.clear();
+    total = 0;
+    cache.clear();
+    cacheValid = true;
+}
+
+std::vector<int>::const_iterator CustomSet<int>::begin() const { return materialize().begin(); }
+
+std::vector<int>::const_iterator CustomSet<int>::end() const { return materialize().end(); }
+
+const std::vector<int>& CustomSet<int>::getVector() const { return materialize(); }
+
+CustomSet<int> CustomSet<int>::intersection(const CustomSet<int>& other) const {
+    return merge(other, OP_AND);
+}
+
+CustomSet<int> CustomSet<int>::setUnion(const CustomSet<int>& other) const {
+    return merge(other, OP_OR);
+}
+
+CustomSet<int> CustomSet<int>::difference(const CustomSet<int>& other) const {
+    return merge(other, OP_ANDNOT);
+}
+
+CustomSet<int> CustomSet<int>::symmetricDifference(const CustomSet<int>& other) const {
+    return merge(other, OP_XOR);
+}
+
+int CustomSet<int>::intersectionSize(const CustomSet<int>& other) const {
+    int count = 0;
+    size_t i = 0, j = 0;
+    while (i < containers.size() && j < other.containers.size()) {
+        if (containers[i].key < other.containers[j].key) i++;
+        else if (containers[i].key > other.containers[j].key) j++;
+        else count += andCardinality(containers[i++], other.containers[j++]);
+    }
+    return count;
+}
+
+void CustomSet<int>::runOptimize() {
+    for (auto& c : containers) {
+        if (c.type == RUN_CONTAINER) continue;
+        int runs = (c.type == ARRAY_CONTAINER) ? countRunsInArray(c.values) : countRunsInBitmap(c.words);
+        size_t runBytes = static_cast<size_t>(runs) * 4;
+        size_t currentBytes = (c.type == ARRAY_CONTAINER) ? c.values.size() * 2 : CHUNK_WORDS * 8;
+        if (runBytes >= currentBytes) continue;
+
+        toArray(c);
+        std::vector<unsigned short> runList;
+        runList.reserve(runs * 2);
+        size_t k = 0;
+        while (k < c.values.size()) {
+            size_t start = k;
+            while (k + 1 < c.values.size() && c.values[k + 1] == c.values[k] + 1) k++;
+            runList.push_back(c.values[start]);
+            runList.push_back(static_cast<unsigned short>(k - start));
+            k++;
+        }
+        c.values.swap(runList);
+        c.values.shrink_to_fit();
+        c.type = RUN_CONTAINER;
+    }
+}
+
+size_t CustomSet<int>::memoryBytes() const {
+    size_t bytes = sizeof(*this) + containers.capacity() * sizeof(Container);
+    for (const auto& c : containers) {
+        bytes += c.values.capacity() * sizeof(unsigned short);
+        bytes += c.words.capacity() * sizeof(unsigned long long);
+    }
+    return bytes;
+}
+
 // ============================================================================
 // CUSTOMMAP TEMPLATE IMPLEMENTATIONS
 // ============================================================================
@@ -79,6 +510,16 @@ void CustomMap<K, V>::insert(const K& key, const V& val) {
     data.push_back(std::make_pair(key, val));
 }
 
+template<typename K, typename V>
+void CustomMap<K, V>::append(const K& key, const V& val) {
+    data.push_back(std::make_pair(key, val));
+}
+
+template<typename K, typename V>
+void CustomMap<K, V>::reserve(int n) {
+    if (n > 0) data.reserve(static_cast<size_t>(n));
+}
+
 template<typename K, typename V>
 bool CustomMap<K, V>::contains(const K& key) const {
     for (const auto& p : data) if (p.first == key) return true;
@@ -138,13 +579,162 @@ template<typename K, typename V>
 typename std::vector<std::pair<K, V>>::const_iterator CustomMap<K, V>::end() const { return data.end(); }
 
 // Explicit template instantiations
-template class CustomSet<int>;
 template class CustomMap<std::string, int>;
 template class CustomMap<int, int>;
 template class CustomMap<std::pair<int, int>, bool>;
 template class CustomMap<int, std::vector<int>>;
 template class CustomMap<std::string, bool>;
 
+// ============================================================================
+// STRING POOL IMPLEMENTATION
+// ============================================================================
+
+const StringPool::Id StringPool::NONE;
+
+StringPool::StringPool() : blockUsed(0), blockCapacity(0), arenaBytes(0), table(64, NONE) {}
+
+size_t StringPool::hash(std::string_view s) {
+    // 64-bit FNV-1a
+    unsigned long long h = 1469598103934665603ULL;
+    for (unsigned char ch : s) {
+        h ^= ch;
+        h *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(h);
+}
+
+const char* StringPool::store(std::string_view s) {
+    const size_t BLOCK_SIZE = 64 * 1024;
+    if (s.size() > blockCapacity - blockUsed) {
+        size_t capacity = std::max(BLOCK_SIZE, s.size());
+        blocks.push_back(std::unique_ptr<char[]>(new char[capacity]));
+        blockUsed = 0;
+        blockCapacity = capacity;
+        arenaBytes += capacity;
+    }
+    char* dest = blocks.back().get() + blockUsed;
+    std::copy(s.begin(), s.end(), dest);
+    blockUsed += s.size();
+    return dest;
+}
+
+void StringPool::rehash(size_t newSize) {
+    table.assign(newSize, NONE);
+    size_t mask = newSize - 1;
+    for (size_t i = 0; i < entries.size(); i++) {
+        size_t slot = entries[i].hash & mask;
+        while (table[slot] != NONE) slot = (slot + 1) & mask;
+        table[slot] = static_cast<Id>(i);
+    }
+}
+
+StringPool::Id StringPool::find(std::string_view s) const {
+    size_t h = hash(s);
+    size_t mask = table.size() - 1;
+    for (size_t slot = h & mask; table[slot] != NONE; slot = (slot + 1) & mask) {
+        const Entry& e = entries[table[slot]];
+        if (e.hash == h && std::string_view(e.data, e.length) == s) return table[slot];
+    }
+    return NONE;
+}
+
+StringPool::Id StringPool::intern(std::string_view s) {
+    size_t h = hash(s);
+    size_t mask = table.size() - 1;
+    size_t slot = h & mask;
+    for (; table[slot] != NONE; slot = (slot + 1) & mask) {
+        const Entry& e = entries[table[slot]];
+        if (e.hash == h && std::string_view(e.data, e.length) == s) return table[slot];
+    }
+
+    Id id = static_cast<Id>(entries.size());
+    Entry e;
+    e.data = store(s);
+    e.length = static_cast<unsigned int>(s.size());
+    e.hash = h;
+    entries.push_back(e);
+    table[slot] = id;
+    if (entries.size() * 2 > table.size()) rehash(table.size() * 2);
+    return id;
+}
+
+std::string_view StringPool::view(Id id) const {
+    if (id < 0 || id >= static_cast<Id>(entries.size())) return std::string_view();
+    return std::string_view(entries[id].data, entries[id].length);
+}
+
+int StringPool::size() const {
+    return static_cast<int>(entries.size());
+}
+
+size_t StringPool::memoryBytes() const {
+    return arenaBytes + entries.capacity() * sizeof(Entry) + table.capacity() * sizeof(Id);
+}
+
+void StringPool::clear() {
+    blocks.clear();
+    blockUsed = 0;
+    blockCapacity = 0;
+    arenaBytes = 0;
+    entries.clear();
+    table.assign(64, NONE);
+}
+
+// Snapshot layout: entry count, then (length, bytes) per entry in ID order,
+// so reading it back reproduces the same IDs
+void StringPool::write(std::ostream& out) const {
+    unsigned int count = static_cast<unsigned int>(entries.size());
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& e : entries) {
+        out.write(reinterpret_cast<const char*>(&e.length), sizeof(e.length));
+        out.write(e.data, e.length);
+    }
+}
+
+bool StringPool::read(std::istream& in) {
+    unsigned int count = 0;
+    if (!in.read(reinterpret_cast<char*>(&count), sizeof(count))) return false;
+    clear();
+    std::string buffer;
+    for (unsigned int i = 0; i < count; i++) {
+        unsigned int length = 0;
+        if (!in.read(reinterpret_cast<char*>(&length), sizeof(length))) return false;
+        buffer.resize(length);
+        if (length > 0 && !in.read(&buffer[0], length)) return false;
+        if (intern(buffer) != static_cast<Id>(i)) return false;
+    }
+    return true;
+}
+
+StringPool& StringPool::global() {
+    static StringPool pool;
+    return pool;
+}
+
+PooledString::PooledString() : id(StringPool::NONE) {}
+
+PooledString::PooledString(const std::string& s) : id(StringPool::global().intern(s)) {}
+
+PooledString::PooledString(const char* s) : id(StringPool::global().intern(s)) {}
+
+StringPool::Id PooledString::getId() const { return id; }
+
+std::string_view PooledString::view() const { return StringPool::global().view(id); }
+
+std::string PooledString::str() const { return std::string(view()); }
+
+bool PooledString::empty() const { return view().empty(); }
+
+PooledString::operator std::string() const { return str(); }
+
+bool PooledString::operator==(const PooledString& other) const { return id == other.id; }
+
+bool PooledString::operator!=(const PooledString& other) const { return id != other.id; }
+
+std::ostream& operator<<(std::ostream& out, const PooledString& s) {
+    return out << s.view();
+}
+
 // ============================================================================
 // RELATIONS IMPLEMENTATION
 // ============================================================================
@@ -153,6 +743,7 @@ Relations::Relations() : size(0) {}
 
 void Relations::ensureSize(int n) {
     if (n > size) {
+        for (auto& row : prereq) row.resize(n, false);
         prereq.resize(n, std::vector<bool>(n, false));
         size = n;
     }
@@ -163,6 +754,31 @@ void Relations::addPrereq(int a, int b) {
     prereq[a][b] = true;
 }
 
+void Relations::removeCourse(int id) {
+    if (id < 0 || id >= size) return;
+    for (int i = 0; i < size; i++) {
+        prereq[i][id] = false;
+        prereq[id][i] = false;
+    }
+}
+
+// newIds[old] is the course's new ID, or -1 if it was dropped
+void Relations::remap(const std::vector<int>& newIds) {
+    int newSize = 0;
+    for (int i = 0; i < size && i < static_cast<int>(newIds.size()); i++) {
+        newSize = std::max(newSize, newIds[i] + 1);
+    }
+    std::vector<std::vector<bool>> remapped(newSize, std::vector<bool>(newSize, false));
+    for (int i = 0; i < size && i < static_cast<int>(newIds.size()); i++) {
+        if (newIds[i] < 0) continue;
+        for (int j = 0; j < size && j < static_cast<int>(newIds.size()); j++) {
+            if (prereq[i][j] && newIds[j] >= 0) remapped[newIds[i]][newIds[j]] = true;
+        }
+    }
+    prereq.swap(remapped);
+    size = newSize;
+}
+
 bool Relations::getPrereq(int a, int b) const {
     if (a < 0 || b < 0 || a >= size || b >= size) return false;
     return prereq[a][b];
@@ -240,33 +856,126 @@ const std::vector<std::vector<bool>>& Relations::getPrereqMatrix() const {
 // FUNCTIONS IMPLEMENTATION
 // ============================================================================
 
-bool Functions::isInjective(const CustomMap<int, int>& f) {
-    CustomSet<int> values;
+namespace {
+
+// A range counts as dense when a flat table over it is at most a few times
+// larger than the map itself
+bool isDenseRange(long long lo, long long hi, int count) {
+    return count > 0 && hi - lo + 1 <= 4LL * count + 1024;
+}
+
+// Number of distinct values of f, flagging any value seen twice
+int countDistinctValues(const CustomMap<int, int>& f, bool stopAtRepeat, bool& repeated) {
+    repeated = false;
+    if (f.empty()) return 0;
+    long long lo = f.begin()->second, hi = lo;
     for (const auto& pair : f) {
-        if (values.contains(pair.second)) return false;
-        values.insert(pair.second);
+        lo = std::min<long long>(lo, pair.second);
+        hi = std::max<long long>(hi, pair.second);
     }
-    return true;
+
+    int distinct = 0;
+    if (isDenseRange(lo, hi, f.size())) {
+        std::vector<unsigned long long> seen(static_cast<size_t>((hi - lo) / 64 + 1), 0ULL);
+        for (const auto& pair : f) {
+            unsigned long long offset = static_cast<unsigned long long>(pair.second - lo);
+            unsigned long long bit = 1ULL << (offset & 63);
+            unsigned long long& word = seen[static_cast<size_t>(offset >> 6)];
+            if (word & bit) {
+                repeated = true;
+                if (stopAtRepeat) return distinct;
+            } else {
+                word |= bit;
+                distinct++;
+            }
+        }
+    } else {
+        std::unordered_set<int> seen;
+        seen.reserve(static_cast<size_t>(f.size()) * 2);
+        for (const auto& pair : f) {
+            if (!seen.insert(pair.second).second) {
+                repeated = true;
+                if (stopAtRepeat) return distinct;
+            } else {
+                distinct++;
+            }
+        }
+    }
+    return distinct;
 }
 
-bool Functions::isSurjective(const CustomMap<int, int>& f, int codomainSize) {
-    CustomSet<int> values;
-    for (const auto& pair : f) {
-        values.insert(pair.second);
+// O(1) key lookup over a CustomMap<int, int>: offset table when keys are dense
+class KeyLookup {
+private:
+    bool dense;
+    long long base;
+    std::vector<int> values;
+    std::vector<unsigned long long> present;
+    std::unordered_map<int, int> sparse;
+
+public:
+    explicit KeyLookup(const CustomMap<int, int>& f) : dense(false), base(0) {
+        if (f.empty()) return;
+        long long lo = f.begin()->first, hi = lo;
+        for (const auto& pair : f) {
+            lo = std::min<long long>(lo, pair.first);
+            hi = std::max<long long>(hi, pair.first);
+        }
+        if (isDenseRange(lo, hi, f.size())) {
+            dense = true;
+            base = lo;
+            values.assign(static_cast<size_t>(hi - lo + 1), 0);
+            present.assign(static_cast<size_t>((hi - lo) / 64 + 1), 0ULL);
+            for (const auto& pair : f) {
+                size_t offset = static_cast<size_t>(pair.first - lo);
+                values[offset] = pair.second;
+                present[offset >> 6] |= 1ULL << (offset & 63);
+            }
+        } else {
+            sparse.reserve(static_cast<size_t>(f.size()) * 2);
+            for (const auto& pair : f) sparse[pair.first] = pair.second;
+        }
+    }
+
+    const int* find(int key) const {
+        if (dense) {
+            long long offset = key - base;
+            if (offset < 0 || offset >= static_cast<long long>(values.size())) return nullptr;
+            if (!(present[static_cast<size_t>(offset) >> 6] & (1ULL << (offset & 63)))) return nullptr;
+            return &values[static_cast<size_t>(offset)];
+        }
+        auto it = sparse.find(key);
+        return it == sparse.end() ? nullptr : &it->second;
     }
-    return values.size() == codomainSize;
+};
+
+} // namespace
+
+bool Functions::isInjective(const CustomMap<int, int>& f) {
+    bool repeated;
+    countDistinctValues(f, true, repeated);
+    return !repeated;
+}
+
+bool Functions::isSurjective(const CustomMap<int, int>& f, int codomainSize) {
+    bool repeated;
+    return countDistinctValues(f, false, repeated) == codomainSize;
 }
 
 bool Functions::isBijective(const CustomMap<int, int>& f, int codomainSize) {
-    return isInjective(f) && isSurjective(f, codomainSize);
+    bool repeated;
+    int distinct = countDistinctValues(f, false, repeated);
+    return !repeated && distinct == codomainSize;
 }
 
 CustomMap<int, int> Functions::compose(const CustomMap<int, int>& f, const CustomMap<int, int>& g) {
     CustomMap<int, int> result;
+    KeyLookup lookup(g);
+    result.reserve(f.size());
     for (const auto& pair : f) {
-        const int* gval = g.get(pair.second);
+        const int* gval = lookup.find(pair.second);
         if (gval) {
-            result.insert(pair.first, *gval);
+            result.append(pair.first, *gval);
         }
     }
     return result;
@@ -280,8 +989,9 @@ CustomMap<int, int> Functions::inverse(const CustomMap<int, int>& f, int codomai
         return inv;
     }
 
+    inv.reserve(f.size());
     for (const auto& pair : f) {
-        inv.insert(pair.second, pair.first);
+        inv.append(pair.second, pair.first);
     }
 
     std::cout << "[SUCCESS] Inverse function created\n";
@@ -289,8 +999,9 @@ CustomMap<int, int> Functions::inverse(const CustomMap<int, int>& f, int codomai
 }
 
 bool Functions::verifyInverse(const CustomMap<int, int>& f, const CustomMap<int, int>& f_inv) {
+    KeyLookup lookup(f_inv);
     for (const auto& pair : f) {
-        const int* inv_val = f_inv.get(pair.second);
+        const int* inv_val = lookup.find(pair.second);
         if (!inv_val || *inv_val != pair.first) {
             return false;
         }
@@ -300,14 +1011,18 @@ bool Functions::verifyInverse(const CustomMap<int, int>& f, const CustomMap<int,
 
 std::vector<CustomSet<int>> Functions::powerSet(const CustomSet<int>& s) {
     std::vector<CustomSet<int>> result;
-    result.push_back(CustomSet<int>());
-
-    for (const auto& elem : s.getVector()) {
-        int currentSize = static_cast<int>(result.size());
-        for (int i = 0; i < currentSize; i++) {
-            CustomSet<int> newSet = result[i];
-            newSet.insert(elem);
-            result.push_back(newSet);
+    const std::vector<int>& elements = s.getVector();
+    int n = static_cast<int>(elements.size());
+    if (n > 24) {
+        std::cout << "[ERROR] Power set of " << n << " elements is too large to store\n";
+        return result;
+    }
+    // Each subset is built straight from its mask; elements arrive in ascending order
+    unsigned long long count = 1ULL << n;
+    result.resize(static_cast<size_t>(count));
+    for (unsigned long long mask = 1; mask < count; mask++) {
+        for (unsigned long long bits = mask; bits; bits &= bits - 1) {
+            result[static_cast<size_t>(mask)].insert(elements[lowestBit(bits)]);
         }
     }
     return result;
@@ -328,40 +1043,23 @@ std::vector<std::pair<int, int>> Functions::cartesianProduct(const CustomSet<int
 // ============================================================================
 
 CustomSet<int> SetOps::setIntersection(const CustomSet<int>& a, const CustomSet<int>& b) {
-    CustomSet<int> result;
-    for (const auto& x : a.getVector()) {
-        if (b.contains(x)) result.insert(x);
-    }
-    return result;
+    return a.intersection(b);
 }
 
 CustomSet<int> SetOps::setUnion(const CustomSet<int>& a, const CustomSet<int>& b) {
-    CustomSet<int> result;
-    for (const auto& x : a.getVector()) result.insert(x);
-    for (const auto& x : b.getVector()) result.insert(x);
-    return result;
+    return a.setUnion(b);
 }
 
 CustomSet<int> SetOps::setDifference(const CustomSet<int>& a, const CustomSet<int>& b) {
-    CustomSet<int> result;
-    for (const auto& x : a.getVector()) {
-        if (!b.contains(x)) result.insert(x);
-    }
-    return result;
+    return a.difference(b);
 }
 
 CustomSet<int> SetOps::symmetricDifference(const CustomSet<int>& a, const CustomSet<int>& b) {
-    CustomSet<int> result;
-    for (const auto& x : a.getVector()) if (!b.contains(x)) result.insert(x);
-    for (const auto& x : b.getVector()) if (!a.contains(x)) result.insert(x);
-    return result;
+    return a.symmetricDifference(b);
 }
 
 bool SetOps::isSubset(const CustomSet<int>& a, const CustomSet<int>& b) {
-    for (const auto& x : a.getVector()) {
-        if (!b.contains(x)) return false;
-    }
-    return true;
+    return a.size() <= b.size() && a.intersectionSize(b) == a.size();
 }
 
 bool SetOps::isSuperset(const CustomSet<int>& a, const CustomSet<int>& b) {
@@ -369,10 +1067,11 @@ bool SetOps::isSuperset(const CustomSet<int>& a, const CustomSet<int>& b) {
 }
 
 bool SetOps::areDisjoint(const CustomSet<int>& a, const CustomSet<int>& b) {
-    for (const auto& x : a.getVector()) {
-        if (b.contains(x)) return false;
-    }
-    return true;
+    return a.intersectionSize(b) == 0;
+}
+
+int SetOps::intersectionSize(const CustomSet<int>& a, const CustomSet<int>& b) {
+    return a.intersectionSize(b);
 }
 
 // ============================================================================
@@ -420,29 +1119,88 @@ void LogicEngine::listRules() const {
 // INDUCTION IMPLEMENTATION
 // ============================================================================
 
-bool Induction::provePrereqDepth(const Relations& rel, int maxDepth) {
-    auto closure = rel.closurePrereq();
-    int size = rel.getSize();
-    
-    // Base case: depth 0
-    std::cout << "[BASE CASE] Depth 0: All courses with no prerequisites\n";
-    
-    // Inductive step
-    for (int depth = 1; depth <= maxDepth; depth++) {
-        bool found = false;
-        for (int i = 0; i < size; i++) {
-            int prereqCount = 0;
-            for (int j = 0; j < size; j++) {
-                if (closure[j][i]) prereqCount++;
+bool PrereqLayers::acyclic() const { return unreached == 0; }
+
+int PrereqLayers::height() const { return static_cast<int>(layerSize.size()); }
+
+PrereqLayers Induction::layerPrereqs(const Relations& rel) {
+    int n = rel.getSize();
+    const auto& prereq = rel.getPrereqMatrix();
+    PrereqLayers layers;
+    layers.depth.assign(n, -1);
+    layers.ancestorCount.assign(n, -1);
+    layers.order.reserve(n);
+
+    std::vector<std::vector<int>> next(n);
+    std::vector<int> waiting(n, 0);
+    for (int a = 0; a < n; a++) {
+        for (int b = 0; b < n; b++) {
+            if (prereq[a][b] && a != b) {
+                next[a].push_back(b);
+                waiting[b]++;
             }
-            if (prereqCount == depth) found = true;
         }
-        if (found) {
-            std::cout << "[INDUCTIVE STEP] Depth " << depth << ": Courses with " << depth << " prerequisite(s) exist\n";
+    }
+    for (int c = 0; c < n; c++) {
+        if (waiting[c] == 0 && !prereq[c][c]) {
+            layers.depth[c] = 0;
+            layers.order.push_back(c);
+        }
+    }
+
+    // A course's ancestor row is only needed until it is dequeued, so rows
+    // are allocated on first use and released right after
+    size_t words = (static_cast<size_t>(n) + 63) / 64;
+    std::vector<std::vector<unsigned long long>> ancestors(n);
+    for (size_t i = 0; i < layers.order.size(); i++) {
+        int u = layers.order[i];
+        std::vector<unsigned long long> row;
+        row.swap(ancestors[u]);
+        int count = 0;
+        for (unsigned long long w : row) count += popcount64(w);
+        layers.ancestorCount[u] = count;
+
+        for (int v : next[u]) {
+            auto& target = ancestors[v];
+            if (target.empty()) target.assign(words, 0ULL);
+            for (size_t w = 0; w < row.size(); w++) target[w] |= row[w];
+            target[u / 64] |= 1ULL << (u % 64);
+            layers.depth[v] = std::max(layers.depth[v], layers.depth[u] + 1);
+            if (--waiting[v] == 0) layers.order.push_back(v);
         }
     }
-    
-    return true;
+
+    layers.unreached = n - static_cast<int>(layers.order.size());
+    for (int u : layers.order) {
+        if (layers.depth[u] >= static_cast<int>(layers.layerSize.size())) layers.layerSize.resize(layers.depth[u] + 1, 0);
+        layers.layerSize[layers.depth[u]]++;
+    }
+    for (int c = 0; c < n; c++) {
+        if (layers.ancestorCount[c] < 0) layers.depth[c] = -1;
+    }
+    return layers;
+}
+
+// Induction on chain depth: layer 0 has no prerequisites, and every course
+// in layer d has all of its prerequisites in layers below d
+bool Induction::provePrereqDepth(const Relations& rel, int maxDepth) {
+    PrereqLayers layers = layerPrereqs(rel);
+
+    std::cout << "[BASE CASE] Depth 0: " << (layers.height() > 0 ? layers.layerSize[0] : 0)
+              << " course(s) with no prerequisites\n";
+
+    int shown = std::min(maxDepth, layers.height() - 1);
+    for (int depth = 1; depth <= shown; depth++) {
+        std::cout << "[INDUCTIVE STEP] Depth " << depth << ": " << layers.layerSize[depth]
+                  << " course(s), each one step above a prerequisite at depth " << depth - 1 << "\n";
+    }
+    if (shown < layers.height() - 1) {
+        std::cout << "[NOTE] Layers " << shown + 1 << " to " << layers.height() - 1 << " not shown\n";
+    }
+    if (!layers.acyclic()) {
+        std::cout << "[FAIL] " << layers.unreached << " course(s) lie on or behind a prerequisite cycle\n";
+    }
+    return layers.acyclic();
 }
 
 void Induction::displayProof() {
@@ -5,6 +5,9 @@
 #include <string>
 #include <algorithm>
 #include <utility>
+#include <memory>
+#include <string_view>
+#include <iosfwd>
 
 // ============================================================================
 // BASIC DATA STRUCTURES - Sets and Maps
@@ -30,12 +33,72 @@ public:
     CustomSet<T> setUnion(const CustomSet<T>& other) const;
 };
 
+// ============================================================================
+// COMPRESSED BITMAP SET - CustomSet<int> specialization
+// ============================================================================
+// Integer sets (rosters, enrolled courses, function value sets) are split into
+// 2^16-wide chunks keyed by the high 16 bits. Each chunk is stored as a sorted
+// array (sparse), a 1024-word bitmap (dense) or a list of runs (contiguous IDs).
+// Iteration is in ascending order.
+
+template<>
+class CustomSet<int> {
+private:
+    enum ContainerType { ARRAY_CONTAINER, BITMAP_CONTAINER, RUN_CONTAINER };
+    enum SetOp { OP_AND, OP_OR, OP_ANDNOT, OP_XOR };
+
+    struct Container {
+        unsigned short key;
+        ContainerType type;
+        int cardinality;
+        std::vector<unsigned short> values;      // array: sorted lows, run: (start, length-1) pairs
+        std::vector<unsigned long long> words;   // bitmap: 1024 words
+    };
+
+    std::vector<Container> containers;
+    int total;
+    mutable std::vector<int> cache;
+    mutable bool cacheValid;
+
+    int findContainer(unsigned short key) const;
+    static bool containerContains(const Container& c, unsigned short low);
+    static void toArray(Container& c);
+    static void toBitmap(Container& c);
+    static void expandRuns(Container& c);
+    static Container combine(const Container& a, const Container& b, SetOp op);
+    static int andCardinality(const Container& a, const Container& b);
+    CustomSet<int> merge(const CustomSet<int>& other, SetOp op) const;
+    const std::vector<int>& materialize() const;
+
+public:
+    CustomSet();
+    void insert(const int& val);
+    bool contains(const int& val) const;
+    void erase(const int& val);
+    int size() const;
+    bool empty() const;
+    void clear();
+    std::vector<int>::const_iterator begin() const;
+    std::vector<int>::const_iterator end() const;
+    const std::vector<int>& getVector() const;
+    CustomSet<int> intersection(const CustomSet<int>& other) const;
+    CustomSet<int> setUnion(const CustomSet<int>& other) const;
+    CustomSet<int> difference(const CustomSet<int>& other) const;
+    CustomSet<int> symmetricDifference(const CustomSet<int>& other) const;
+    int intersectionSize(const CustomSet<int>& other) const;
+    void runOptimize();
+    size_t memoryBytes() const;
+};
+
 template<typename K, typename V>
 class CustomMap {
 private:
     std::vector<std::pair<K, V>> data;
 public:
     void insert(const K& key, const V& val);
+    // Bulk-build path: skips the duplicate scan, so the key must not be present
+    void append(const K& key, const V& val);
+    void reserve(int n);
     bool contains(const K& key) const;
     V* get(const K& key);
     const V* get(const K& key) const;
@@ -51,6 +114,69 @@ public:
     typename std::vector<std::pair<K, V>>::const_iterator end() const;
 };
 
+// ============================================================================
+// STRING POOL - Interned codes and names
+// ============================================================================
+// Each distinct string is copied once into append-only arena blocks and gets
+// a dense ID. Blocks never move, so views stay valid for the pool's lifetime.
+// Not synchronized: intern from one thread at a time.
+
+class StringPool {
+public:
+    typedef int Id;
+    static const Id NONE = -1;
+
+private:
+    struct Entry {
+        const char* data;
+        unsigned int length;
+        size_t hash;
+    };
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t blockUsed;
+    size_t blockCapacity;
+    size_t arenaBytes;
+    std::vector<Entry> entries;
+    std::vector<Id> table;
+
+    const char* store(std::string_view s);
+    void rehash(size_t newSize);
+
+public:
+    StringPool();
+    Id intern(std::string_view s);
+    Id find(std::string_view s) const;
+    std::string_view view(Id id) const;
+    int size() const;
+    size_t memoryBytes() const;
+    void clear();
+    void write(std::ostream& out) const;
+    bool read(std::istream& in);
+    static size_t hash(std::string_view s);
+    static StringPool& global();
+};
+
+// Handle to a string in the global pool; equality compares IDs
+class PooledString {
+private:
+    StringPool::Id id;
+
+public:
+    PooledString();
+    PooledString(const std::string& s);
+    PooledString(const char* s);
+    StringPool::Id getId() const;
+    std::string_view view() const;
+    std::string str() const;
+    bool empty() const;
+    operator std::string() const;
+    bool operator==(const PooledString& other) const;
+    bool operator!=(const PooledString& other) const;
+};
+
+std::ostream& operator<<(std::ostream& out, const PooledString& s);
+
 // ============================================================================
 // RELATIONS
 // ============================================================================
@@ -63,6 +189,8 @@ public:
     Relations();
     void ensureSize(int n);
     void addPrereq(int a, int b);
+    void removeCourse(int id);
+    void remap(const std::vector<int>& newIds);
     bool getPrereq(int a, int b) const;
     int getSize() const;
     std::vector<std::vector<bool>> closurePrereq() const;
@@ -80,6 +208,9 @@ public:
 // FUNCTIONS - Analysis and Properties
 // ============================================================================
 
+// Properties, composition and inversion index the maps once. Keys or values
+// confined to a narrow range use flat arrays and bitsets; anything sparser
+// falls back to hashing.
 class Functions {
 public:
     static bool isInjective(const CustomMap<int, int>& f);
@@ -105,6 +236,7 @@ public:
     static bool isSubset(const CustomSet<int>& a, const CustomSet<int>& b);
     static bool isSuperset(const CustomSet<int>& a, const CustomSet<int>& b);
     static bool areDisjoint(const CustomSet<int>& a, const CustomSet<int>& b);
+    static int intersectionSize(const CustomSet<int>& a, const CustomSet<int>& b);
 };
 
 // ============================================================================
@@ -133,8 +265,26 @@ public:
 // INDUCTION PROOFS
 // ============================================================================
 
+// Longest-path layering of the prerequisite DAG, built in one topological
+// pass. depth[c] is the length of the longest prerequisite chain ending at
+// c: depth 0 holds the courses with no prerequisites and every other course
+// sits one layer above its deepest prerequisite. Ancestor sets are bit rows
+// OR-ed along the same order and counted by popcount. Courses on or behind
+// a cycle are never reached and get depth and ancestor count -1.
+struct PrereqLayers {
+    std::vector<int> depth;
+    std::vector<int> ancestorCount;
+    std::vector<int> layerSize;
+    std::vector<int> order;
+    int unreached;
+
+    bool acyclic() const;
+    int height() const;
+};
+
 class Induction {
 public:
+    static PrereqLayers layerPrereqs(const Relations& rel);
     static bool provePrereqDepth(const Relations& rel, int maxDepth);
     static void displayProof();
 };
@@ -0,0 +1,343 @@
+#include "FormulaModule.h"
+#include "CourseManager.h"
+#include <iostream>
+#include <algorithm>
+#include <unordered_set>
+#include <climits>
+#include <cctype>
+
+const BddManager::Ref BddManager::FALSE_REF;
+const BddManager::Ref BddManager::TRUE_REF;
+
+BddManager::BddManager() {
+    nodes.push_back({ INT_MAX, FALSE_REF, FALSE_REF });
+    nodes.push_back({ INT_MAX, TRUE_REF, TRUE_REF });
+}
+
+BddManager::Ref BddManager::make(int var, Ref low, Ref high) {
+    if (low == high) return low;
+    Key key{ var, low, high };
+    auto it = unique.find(key);
+    if (it != unique.end()) return it->second;
+    Ref r = (Ref)nodes.size();
+    nodes.push_back({ var, low, high });
+    unique.emplace(key, r);
+    return r;
+}
+
+BddManager::Ref BddManager::apply(Op op, Ref f, Ref g) {
+    switch (op) {
+    case OP_NOT:
+        if (f <= TRUE_REF) return f == TRUE_REF ? FALSE_REF : TRUE_REF;
+        break;
+    case OP_AND:
+        if (f == FALSE_REF || g == FALSE_REF) return FALSE_REF;
+        if (f == TRUE_REF || f == g) return g;
+        if (g == TRUE_REF) return f;
+        break;
+    case OP_OR:
+        if (f == TRUE_REF || g == TRUE_REF) return TRUE_REF;
+        if (f == FALSE_REF || f == g) return g;
+        if (g == FALSE_REF) return f;
+        break;
+    }
+    if (op != OP_NOT && f > g) std::swap(f, g);
+
+    Key key{ op, f, g };
+    auto it = computed.find(key);
+    if (it != computed.end()) return it->second;
+
+    // Copy out before recursing: make() may reallocate nodes
+    Node nf = nodes[f];
+    Node ng = op == OP_NOT ? nf : nodes[g];
+    int var = std::min(nf.var, ng.var);
+    Ref fLow = nf.var == var ? nf.low : f;
+    Ref fHigh = nf.var == var ? nf.high : f;
+    Ref gLow = ng.var == var ? ng.low : g;
+    Ref gHigh = ng.var == var ? ng.high : g;
+
+    Ref low = apply(op, fLow, gLow);
+    Ref high = apply(op, fHigh, gHigh);
+    Ref r = make(var, low, high);
+    computed.emplace(key, r);
+    return r;
+}
+
+std::vector<BddManager::Ref> BddManager::reachable(Ref root) const {
+    std::vector<Ref> result;
+    std::unordered_set<Ref> seen;
+    std::vector<Ref> stack{ root };
+    seen.insert(root);
+    while (!stack.empty()) {
+        Ref r = stack.back();
+        stack.pop_back();
+        result.push_back(r);
+        if (r <= TRUE_REF) continue;
+        for (Ref child : { nodes[r].low, nodes[r].high }) {
+            if (seen.insert(child).second) stack.push_back(child);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+BddManager::Ref BddManager::variable(int courseId) { return make(courseId, FALSE_REF, TRUE_REF); }
+
+BddManager::Ref BddManager::negate(Ref f) { return apply(OP_NOT, f, FALSE_REF); }
+
+BddManager::Ref BddManager::conjoin(Ref f, Ref g) { return apply(OP_AND, f, g); }
+
+BddManager::Ref BddManager::disjoin(Ref f, Ref g) { return apply(OP_OR, f, g); }
+
+bool BddManager::evaluate(Ref f, const std::vector<bool>& completed) const {
+    while (f > TRUE_REF) {
+        const Node& n = nodes[f];
+        f = n.var < (int)completed.size() && completed[n.var] ? n.high : n.low;
+    }
+    return f == TRUE_REF;
+}
+
+// Cheapest path to TRUE where taking a course the student lacks costs one.
+// A completed course cannot be untaken, so its low edge is closed. Nodes
+// are visited children first (ascending Ref), so one pass prices them all.
+bool BddManager::minimalMissing(Ref f, const std::vector<bool>& completed, std::vector<int>& missing) const {
+    missing.clear();
+    std::vector<Ref> order = reachable(f);
+    auto slot = [&](Ref r) { return (int)(std::lower_bound(order.begin(), order.end(), r) - order.begin()); };
+
+    const int INF = INT_MAX / 2;
+    std::vector<int> cost(order.size(), INF);
+    std::vector<bool> takeHigh(order.size(), false);
+    for (int i = 0; i < (int)order.size(); i++) {
+        Ref r = order[i];
+        if (r <= TRUE_REF) {
+            cost[i] = r == TRUE_REF ? 0 : INF;
+            continue;
+        }
+        const Node& n = nodes[r];
+        bool done = n.var < (int)completed.size() && completed[n.var];
+        int viaLow = done ? INF : cost[slot(n.low)];
+        int viaHigh = cost[slot(n.high)] + (done ? 0 : 1);
+        takeHigh[i] = viaHigh < viaLow;
+        cost[i] = std::min(std::min(viaLow, viaHigh), INF);
+    }
+    if (cost[slot(f)] >= INF) return false;
+
+    while (f > TRUE_REF) {
+        const Node& n = nodes[f];
+        if (takeHigh[slot(f)]) {
+            if (!(n.var < (int)completed.size() && completed[n.var])) missing.push_back(n.var);
+            f = n.high;
+        }
+        else f = n.low;
+    }
+    return true;
+}
+
+std::vector<int> BddManager::support(Ref f) const {
+    std::vector<int> vars;
+    for (Ref r : reachable(f)) {
+        if (r > TRUE_REF) vars.push_back(nodes[r].var);
+    }
+    std::sort(vars.begin(), vars.end());
+    vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+    return vars;
+}
+
+int BddManager::nodeCount() const { return (int)nodes.size(); }
+
+void BddManager::clearCache() { computed.clear(); }
+
+namespace {
+
+enum TokenType { TOK_CODE, TOK_AND, TOK_OR, TOK_NOT, TOK_LPAREN, TOK_RPAREN, TOK_END };
+
+struct Token {
+    TokenType type;
+    std::string text;
+};
+
+bool tokenize(const std::string& text, std::vector<Token>& tokens, std::string& error) {
+    size_t i = 0;
+    while (i < text.size()) {
+        char ch = text[i];
+        if (std::isspace((unsigned char)ch)) { i++; continue; }
+        if (ch == '(') { tokens.push_back({ TOK_LPAREN, "(" }); i++; continue; }
+        if (ch == ')') { tokens.push_back({ TOK_RPAREN, ")" }); i++; continue; }
+        if (ch == '!') { tokens.push_back({ TOK_NOT, "!" }); i++; continue; }
+        if (ch == '&' || ch == '|') {
+            tokens.push_back({ ch == '&' ? TOK_AND : TOK_OR, std::string(1, ch) });
+            i += i + 1 < text.size() && text[i + 1] == ch ? 2 : 1;
+            continue;
+        }
+        if (std::isalnum((unsigned char)ch) || ch == '_' || ch == '-' || ch == '.') {
+            size_t start = i;
+            while (i < text.size() && (std::isalnum((unsigned char)text[i]) || text[i] == '_' || text[i] == '-' || text[i] == '.')) i++;
+            std::string word = text.substr(start, i - start);
+            std::string upper = word;
+            for (char& c : upper) c = (char)std::toupper((unsigned char)c);
+            if (upper == "AND") tokens.push_back({ TOK_AND, word });
+            else if (upper == "OR") tokens.push_back({ TOK_OR, word });
+            else if (upper == "NOT") tokens.push_back({ TOK_NOT, word });
+            else tokens.push_back({ TOK_CODE, word });
+            continue;
+        }
+        error = std::string("Unexpected character '") + ch + "' at position " + std::to_string(i);
+        return false;
+    }
+    tokens.push_back({ TOK_END, "" });
+    return true;
+}
+
+// expr := term (OR term)*, term := factor (AND factor)*,
+// factor := NOT factor | '(' expr ')' | course code
+class FormulaParser {
+private:
+    const std::vector<Token>& tokens;
+    const CourseManager& cm;
+    BddManager& bdd;
+    size_t pos;
+    std::string& error;
+
+    bool factor(BddManager::Ref& out) {
+        const Token& t = tokens[pos];
+        if (t.type == TOK_NOT) {
+            pos++;
+            BddManager::Ref inner;
+            if (!factor(inner)) return false;
+            out = bdd.negate(inner);
+            return true;
+        }
+        if (t.type == TOK_LPAREN) {
+            pos++;
+            if (!expr(out)) return false;
+            if (tokens[pos].type != TOK_RPAREN) {
+                error = "Missing ')'";
+                return false;
+            }
+            pos++;
+            return true;
+        }
+        if (t.type == TOK_CODE) {
+            int id = cm.getCourseByCode(t.text);
+            if (id < 0) {
+                error = "Unknown course code: " + t.text;
+                return false;
+            }
+            pos++;
+            out = bdd.variable(id);
+            return true;
+        }
+        error = t.type == TOK_END ? "Unexpected end of expression" : "Unexpected '" + t.text + "'";
+        return false;
+    }
+
+    bool term(BddManager::Ref& out) {
+        if (!factor(out)) return false;
+        while (tokens[pos].type == TOK_AND) {
+            pos++;
+            BddManager::Ref rhs;
+            if (!factor(rhs)) return false;
+            out = bdd.conjoin(out, rhs);
+        }
+        return true;
+    }
+
+public:
+    FormulaParser(const std::vector<Token>& tokens, const CourseManager& cm, BddManager& bdd, std::string& error)
+        : tokens(tokens), cm(cm), bdd(bdd), pos(0), error(error) {}
+
+    bool expr(BddManager::Ref& out) {
+        if (!term(out)) return false;
+        while (tokens[pos].type == TOK_OR) {
+            pos++;
+            BddManager::Ref rhs;
+            if (!term(rhs)) return false;
+            out = bdd.disjoin(out, rhs);
+        }
+        return true;
+    }
+
+    bool atEnd() const { return tokens[pos].type == TOK_END; }
+    const Token& current() const { return tokens[pos]; }
+};
+
+}
+
+bool Requirements::parse(const std::string& text, const CourseManager& cm, BddManager::Ref& out, std::string& error) {
+    std::vector<Token> tokens;
+    if (!tokenize(text, tokens, error)) return false;
+    FormulaParser parser(tokens, cm, bdd, error);
+    if (!parser.expr(out)) return false;
+    if (!parser.atEnd()) {
+        error = "Unexpected '" + parser.current().text + "'";
+        return false;
+    }
+    return true;
+}
+
+bool Requirements::setRequirement(int courseId, const std::string& text, const CourseManager& cm, std::string& error) {
+    BddManager::Ref f;
+    if (!parse(text, cm, f, error)) return false;
+    setRequirement(courseId, f);
+    source[courseId] = text;
+    return true;
+}
+
+void Requirements::setRequirement(int courseId, BddManager::Ref f) {
+    if (courseId >= (int)required.size()) {
+        required.resize(courseId + 1, BddManager::TRUE_REF);
+        source.resize(courseId + 1);
+    }
+    required[courseId] = f;
+    source[courseId].clear();
+}
+
+bool Requirements::hasRequirement(int courseId) const {
+    return courseId >= 0 && courseId < (int)required.size() && required[courseId] != BddManager::TRUE_REF;
+}
+
+BddManager::Ref Requirements::requirementOf(int courseId) const {
+    return hasRequirement(courseId) ? required[courseId] : BddManager::TRUE_REF;
+}
+
+bool Requirements::isEligible(int courseId, const std::vector<bool>& completed) const {
+    return bdd.evaluate(requirementOf(courseId), completed);
+}
+
+std::vector<int> Requirements::eligibleCourses(int courseCount, const std::vector<bool>& completed) const {
+    std::vector<int> result;
+    for (int c = 0; c < courseCount; c++) {
+        bool done = c < (int)completed.size() && completed[c];
+        if (!done && isEligible(c, completed)) result.push_back(c);
+    }
+    return result;
+}
+
+bool Requirements::minimalMissing(int courseId, const std::vector<bool>& completed, std::vector<int>& missing) const {
+    return bdd.minimalMissing(requirementOf(courseId), completed, missing);
+}
+
+BddManager& Requirements::manager() { return bdd; }
+
+void Requirements::display(int courseId, const CourseManager& cm, const std::vector<bool>& completed) const {
+    const auto* c = cm.getCourse(courseId);
+    std::cout << "\nRequirement for " << (c ? c->code : "Course #" + std::to_string(courseId)) << ": ";
+    if (!hasRequirement(courseId)) {
+        std::cout << "(none)\n";
+        return;
+    }
+    std::cout << (source[courseId].empty() ? "(compiled)" : source[courseId]) << "\n";
+
+    std::vector<int> missing;
+    if (isEligible(courseId, completed)) std::cout << "STATUS: [ELIGIBLE]\n";
+    else if (!minimalMissing(courseId, completed, missing)) std::cout << "STATUS: [UNSATISFIABLE]\n";
+    else {
+        std::cout << "STATUS: [MISSING] Take " << missing.size() << " more: ";
+        for (int id : missing) {
+            const auto* mc = cm.getCourse(id);
+            std::cout << (mc ? mc->code : std::to_string(id)) << " ";
+        }
+        std::cout << "\n";
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef FORMULAMODULE_H
+#define FORMULAMODULE_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+class CourseManager;
+
+// Reduced ordered BDDs over course IDs, ordered by ID. Nodes are hash-consed
+// in a unique table, so equal functions share one Ref and equivalence is a
+// Ref comparison. and/or/not are memoized per operand pair. Children are
+// always created before their parents, so node indexes are a topological
+// order of every diagram.
+class BddManager {
+public:
+    typedef int Ref;
+    static const Ref FALSE_REF = 0;
+    static const Ref TRUE_REF = 1;
+private:
+    struct Node {
+        int var;
+        Ref low;
+        Ref high;
+    };
+    struct Key {
+        int a, b, c;
+        bool operator==(const Key& o) const { return a == o.a && b == o.b && c == o.c; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const {
+            unsigned long long h = (unsigned)k.a * 0x9E3779B97F4A7C15ULL;
+            h ^= ((unsigned long long)(unsigned)k.b << 32 | (unsigned)k.c) + (h << 6) + (h >> 2);
+            return (size_t)(h ^ (h >> 29));
+        }
+    };
+    enum Op { OP_AND, OP_OR, OP_NOT };
+
+    std::vector<Node> nodes;
+    std::unordered_map<Key, Ref, KeyHash> unique;
+    std::unordered_map<Key, Ref, KeyHash> computed;
+
+    Ref make(int var, Ref low, Ref high);
+    Ref apply(Op, Ref, Ref);
+    std::vector<Ref> reachable(Ref) const;
+public:
+    BddManager();
+    Ref variable(int courseId);
+    Ref negate(Ref);
+    Ref conjoin(Ref, Ref);
+    Ref disjoin(Ref, Ref);
+    // One walk from the root: at most one step per course in the formula
+    bool evaluate(Ref, const std::vector<bool>& completed) const;
+    // Fewest courses to add to completed so the formula holds; false if
+    // nothing the student could still take satisfies it
+    bool minimalMissing(Ref, const std::vector<bool>& completed, std::vector<int>& missing) const;
+    std::vector<int> support(Ref) const;
+    int nodeCount() const;
+    void clearCache();
+};
+
+// Prerequisite expressions such as "CS101 AND (MATH101 OR MATH102)".
+// AND/OR/NOT are case-insensitive and may be written &, |, !; AND binds
+// tighter than OR. Each course holds one compiled requirement; courses
+// without one are always eligible.
+class Requirements {
+private:
+    BddManager bdd;
+    std::vector<BddManager::Ref> required;
+    std::vector<std::string> source;
+public:
+    bool parse(const std::string&, const CourseManager&, BddManager::Ref&, std::string& error);
+    bool setRequirement(int courseId, const std::string&, const CourseManager&, std::string& error);
+    void setRequirement(int courseId, BddManager::Ref);
+    bool hasRequirement(int courseId) const;
+    BddManager::Ref requirementOf(int courseId) const;
+    bool isEligible(int courseId, const std::vector<bool>& completed) const;
+    std::vector<int> eligibleCourses(int courseCount, const std::vector<bool>& completed) const;
+    bool minimalMissing(int courseId, const std::vector<bool>& completed, std::vector<int>& missing) const;
+    BddManager& manager();
+    void display(int courseId, const CourseManager&, const std::vector<bool>& completed) const;
+};
+
+#endif
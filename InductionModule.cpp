@@ -1,69 +1,550 @@
 #include "InductionModule.h"
 #include "RelationsModule.h"
 #include "CourseManager.h"
+#include "PeopleManager.h"
+#include "ReportWriter.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <vector>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <numeric>
+#include <climits>
+#include <random>
 
 Scheduling::Scheduling(const Relations& r) : relations(r) {}
 
-void Scheduling::backtrack(const std::vector<std::vector<bool>>& adj, std::vector<bool>& used,
-    std::vector<int>& order, int n, int limit) {
-    if ((int)validOrders.size() >= limit) return;
-    if ((int)order.size() == n) {
-        validOrders.push_back(order);
-        return;
+namespace {
+
+// Depth-first enumeration of topological orders. In-degrees and the ready
+// set are updated incrementally, so each step costs O(out-degree) instead
+// of rescanning the whole matrix.
+struct OrderSearch {
+    const std::vector<std::vector<int>>& succ;
+    std::vector<int> indeg;
+    std::vector<int> ready;
+    std::vector<int> order;
+    int n;
+    long long limit;
+    std::atomic<long long>& emitted;
+    std::atomic<bool>& stop;
+    std::mutex* visitLock;
+    const Scheduling::OrderVisitor& visit;
+
+    OrderSearch(const std::vector<std::vector<int>>& s, const std::vector<int>& d, int count,
+        long long lim, std::atomic<long long>& e, std::atomic<bool>& st, std::mutex* lock,
+        const Scheduling::OrderVisitor& v)
+        : succ(s), indeg(d), n(count), limit(lim), emitted(e), stop(st), visitLock(lock), visit(v) {
+        for (int i = 0; i < n; i++) {
+            if (indeg[i] == 0) ready.push_back(i);
+        }
+        order.reserve(n);
     }
-    for (int i = 0; i < n; i++) {
-        if (used[i]) continue;
-        bool hasIncoming = false;
-        for (int j = 0; j < n; j++) {
-            if (!used[j] && adj[j][i]) {
-                hasIncoming = true;
-                break;
+
+    void emit() {
+        long long index = emitted.fetch_add(1);
+        if (limit >= 0 && index >= limit) {
+            stop = true;
+            return;
+        }
+        bool keepGoing;
+        if (visitLock) {
+            std::lock_guard<std::mutex> guard(*visitLock);
+            keepGoing = visit(order);
+        } else {
+            keepGoing = visit(order);
+        }
+        if (!keepGoing || (limit >= 0 && index + 1 >= limit)) stop = true;
+    }
+
+    // Takes ready[k] as the next course and releases its successors
+    void take(int k) {
+        int course = ready[k];
+        std::swap(ready[k], ready.back());
+        ready.pop_back();
+        order.push_back(course);
+        for (int next : succ[course]) {
+            if (--indeg[next] == 0) ready.push_back(next);
+        }
+    }
+
+    void untake(int k) {
+        int course = order.back();
+        order.pop_back();
+        const std::vector<int>& out = succ[course];
+        for (int i = static_cast<int>(out.size()) - 1; i >= 0; i--) {
+            if (indeg[out[i]]++ == 0) ready.pop_back();
+        }
+        ready.push_back(course);
+        std::swap(ready[k], ready.back());
+    }
+
+    void run() {
+        if (stop) return;
+        if (static_cast<int>(order.size()) == n) {
+            emit();
+            return;
+        }
+        for (int k = 0; k < static_cast<int>(ready.size()) && !stop; k++) {
+            take(k);
+            run();
+            untake(k);
+        }
+    }
+};
+
+}
+
+void Scheduling::buildGraph(int n, std::vector<std::vector<int>>& succ, std::vector<int>& indeg) const {
+    succ.assign(n, std::vector<int>());
+    indeg.assign(n, 0);
+    int limit = std::min(n, relations.getSize());
+    for (int i = 0; i < limit; i++) {
+        for (int j = 0; j < limit; j++) {
+            if (relations.getPrereq(i, j)) {
+                succ[i].push_back(j);
+                indeg[j]++;
             }
         }
-        if (!hasIncoming) {
-            used[i] = true;
-            order.push_back(i);
-            backtrack(adj, used, order, n, limit);
-            order.pop_back();
-            used[i] = false;
+    }
+}
+
+long long Scheduling::forEachOrder(int n, const OrderVisitor& visit, long long limit, int threads) const {
+    if (n <= 0 || limit == 0) return 0;
+    std::vector<std::vector<int>> succ;
+    std::vector<int> indeg;
+    buildGraph(n, succ, indeg);
+
+    std::atomic<long long> emitted(0);
+    std::atomic<bool> stop(false);
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<int> firstChoices;
+    for (int i = 0; i < n; i++) {
+        if (indeg[i] == 0) firstChoices.push_back(i);
+    }
+    threads = std::min(threads, static_cast<int>(firstChoices.size()));
+
+    if (threads <= 1) {
+        OrderSearch search(succ, indeg, n, limit, emitted, stop, nullptr, visit);
+        search.run();
+    } else {
+        // Each worker owns whole subtrees rooted at one first course
+        std::mutex visitLock;
+        std::atomic<int> nextChoice(0);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.push_back(std::thread([&]() {
+                OrderSearch search(succ, indeg, n, limit, emitted, stop, &visitLock, visit);
+                while (!stop) {
+                    int choice = nextChoice.fetch_add(1);
+                    if (choice >= static_cast<int>(firstChoices.size())) break;
+                    int k = static_cast<int>(std::find(search.ready.begin(), search.ready.end(),
+                        firstChoices[choice]) - search.ready.begin());
+                    search.take(k);
+                    search.run();
+                    search.untake(k);
+                }
+            }));
         }
+        for (auto& w : workers) w.join();
     }
+
+    long long total = emitted.load();
+    return (limit >= 0 && total > limit) ? limit : total;
 }
 
 int Scheduling::generateOrders(int n, int limit) {
     validOrders.clear();
+    forEachOrder(n, [this](const std::vector<int>& order) {
+        validOrders.push_back(order);
+        return true;
+    }, limit);
+    return static_cast<int>(validOrders.size());
+}
+
+long long Scheduling::countOrders(int n) const {
     if (n <= 0) return 0;
-    auto adj = relations.getPrereqMatrix();
-    std::vector<bool> used(n, false);
-    std::vector<int> order;
-    backtrack(adj, used, order, n, limit);
-    return validOrders.size();
+    if (n > MAX_COUNT_COURSES) return -1;
+
+    // dp[mask] = number of ways to take exactly the courses in mask first
+    std::vector<std::vector<int>> succ;
+    std::vector<int> indeg;
+    buildGraph(n, succ, indeg);
+    std::vector<unsigned int> predMask(n, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j : succ[i]) predMask[j] |= 1u << i;
+    }
+
+    unsigned int full = (1u << n) - 1;
+    std::vector<long long> dp(static_cast<size_t>(full) + 1, 0);
+    dp[0] = 1;
+    for (unsigned int mask = 0; mask < full; mask++) {
+        if (!dp[mask]) continue;
+        for (int i = 0; i < n; i++) {
+            unsigned int bit = 1u << i;
+            if (!(mask & bit) && (predMask[i] & mask) == predMask[i]) {
+                dp[mask | bit] += dp[mask];
+            }
+        }
+    }
+    return dp[full];
 }
 
-void Scheduling::displayOrders(const CourseManager& cm, int maxDisplay) const {
-    std::cout << "\n" << std::string(60, '=') << "\n VALID COURSE SEQUENCES\n" << std::string(60, '=') << "\n\n";
-    std::cout << "\nTotal sequences found: " << validOrders.size() << "\n\n";
-    int display = std::min(maxDisplay, (int)validOrders.size());
-    for (int i = 0; i < display; i++) {
-        std::cout << "Sequence #" << (i + 1) << ": ";
+void Scheduling::displayOrders(const CourseManager& cm, int maxDisplay, int first) const {
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text(" VALID COURSE SEQUENCES").newline().repeat('=', 60).newline().newline();
+    w.newline().text("Total sequences found: ").number((long long)validOrders.size()).newline().newline();
+    int total = (int)validOrders.size();
+    first = std::max(0, std::min(first, total));
+    int last = std::min(total, first + std::max(0, maxDisplay));
+    // Course codes resolved once, not once per sequence step
+    std::unordered_map<int, const std::string*> labels;
+    for (int i = first; i < last; i++) {
+        w.text("Sequence #").number(i + 1).text(": ");
         for (size_t j = 0; j < validOrders[i].size(); j++) {
-            const auto* c = cm.getCourse(validOrders[i][j]);
-            if (c) std::cout << c->code;
-            else std::cout << validOrders[i][j];
-            if (j < validOrders[i].size() - 1) std::cout << " -> ";
+            int id = validOrders[i][j];
+            auto it = labels.find(id);
+            if (it == labels.end()) {
+                const auto* c = cm.getCourse(id);
+                it = labels.emplace(id, c ? &c->code : nullptr).first;
+            }
+            if (it->second) w.text(*it->second);
+            else w.number(id);
+            if (j + 1 < validOrders[i].size()) w.text(" -> ");
         }
-        std::cout << "\n";
+        w.newline();
     }
-    if ((int)validOrders.size() > maxDisplay) {
-        std::cout << "\n... and " << (validOrders.size() - maxDisplay) << " more sequences\n";
+    if (last < total) {
+        w.newline().text("... and ").number(total - last).text(" more sequences").newline();
     }
 }
 
+SemesterPlanner::SemesterPlanner(const Relations& r, const CourseManager& c) : relations(r), cm(c) {}
+
+int SemesterPlanner::creditsOf(int courseId) const {
+    const auto* c = cm.getCourse(courseId);
+    return c ? c->credits : 0;
+}
+
+std::vector<int> SemesterPlanner::longestPathLayers() const {
+    int n = std::max(cm.count(), relations.getSize());
+    std::vector<int> indeg(n, 0), layer(n, -1), queue;
+    for (int i = 0; i < relations.getSize(); i++)
+        for (int j = 0; j < relations.getSize(); j++)
+            if (relations.getPrereq(i, j)) indeg[j]++;
+    for (int i = 0; i < n; i++) {
+        if (indeg[i] == 0) {
+            layer[i] = 0;
+            queue.push_back(i);
+        }
+    }
+    // Courses left at -1 sit on or behind a prerequisite cycle
+    for (size_t head = 0; head < queue.size(); head++) {
+        int u = queue[head];
+        for (int v = 0; v < relations.getSize(); v++) {
+            if (!relations.getPrereq(u, v)) continue;
+            layer[v] = std::max(layer[v], layer[u] + 1);
+            if (--indeg[v] == 0) queue.push_back(v);
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (indeg[i] > 0) layer[i] = -1;
+    }
+    return layer;
+}
+
+std::vector<int> SemesterPlanner::criticalPathLengths() const {
+    int n = std::max(cm.count(), relations.getSize());
+    std::vector<int> outdeg(n, 0), height(n, 0), queue;
+    for (int i = 0; i < relations.getSize(); i++)
+        for (int j = 0; j < relations.getSize(); j++)
+            if (relations.getPrereq(i, j)) outdeg[i]++;
+    for (int i = 0; i < n; i++) {
+        if (outdeg[i] == 0) {
+            height[i] = 1;
+            queue.push_back(i);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head];
+        for (int u : relations.prerequisitesOf(v)) {
+            height[u] = std::max(height[u], height[v] + 1);
+            if (--outdeg[u] == 0) queue.push_back(u);
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (outdeg[i] > 0) height[i] = -1;
+    }
+    return height;
+}
+
+SemesterPlanner::Plan SemesterPlanner::plan(const std::vector<int>& targets, const std::vector<bool>& completed,
+    int creditCap, int timeBudgetMs) const {
+    Plan result;
+    result.studentId = -1;
+    result.totalCredits = 0;
+    result.lowerBound = 0;
+    result.feasible = false;
+    result.optimal = false;
+
+    int n = std::max(cm.count(), relations.getSize());
+    auto isDone = [&](int c) { return c < static_cast<int>(completed.size()) && completed[c]; };
+
+    // Needed courses: the targets plus every prerequisite not yet completed
+    std::vector<char> needed(n, 0);
+    std::vector<int> stack;
+    if (targets.empty()) {
+        for (int i = 0; i < n; i++) if (!isDone(i)) stack.push_back(i);
+    } else {
+        for (int t : targets) if (t >= 0 && t < n && !isDone(t)) stack.push_back(t);
+    }
+    while (!stack.empty()) {
+        int c = stack.back();
+        stack.pop_back();
+        if (needed[c]) continue;
+        needed[c] = 1;
+        for (int p : relations.prerequisitesOf(c)) {
+            if (!needed[p] && !isDone(p)) stack.push_back(p);
+        }
+    }
+
+    std::vector<int> ids, local(n, -1);
+    for (int i = 0; i < n; i++) {
+        if (needed[i]) {
+            local[i] = static_cast<int>(ids.size());
+            ids.push_back(i);
+        }
+    }
+    int m = static_cast<int>(ids.size());
+    if (m == 0) {
+        result.feasible = true;
+        result.optimal = true;
+        return result;
+    }
+
+    std::vector<int> credits(m), indeg(m, 0), height(m, 1);
+    std::vector<std::vector<int>> succ(m);
+    for (int a = 0; a < m; a++) {
+        credits[a] = creditsOf(ids[a]);
+        result.totalCredits += credits[a];
+        if (credits[a] > creditCap) {
+            const auto* c = cm.getCourse(ids[a]);
+            result.reason = (c ? c->code : std::to_string(ids[a])) + " exceeds the credit cap";
+            return result;
+        }
+        for (int p : relations.prerequisitesOf(ids[a])) {
+            if (local[p] >= 0) {
+                succ[local[p]].push_back(a);
+                indeg[a]++;
+            }
+        }
+    }
+
+    // Topological order, then critical path (longest chain to a sink) in reverse
+    std::vector<int> topo, deg = indeg;
+    for (int a = 0; a < m; a++) if (deg[a] == 0) topo.push_back(a);
+    for (size_t head = 0; head < topo.size(); head++) {
+        for (int b : succ[topo[head]]) if (--deg[b] == 0) topo.push_back(b);
+    }
+    if (static_cast<int>(topo.size()) < m) {
+        result.reason = "prerequisite cycle among required courses";
+        return result;
+    }
+    int longestChain = 0;
+    for (int k = m - 1; k >= 0; k--) {
+        int a = topo[k];
+        for (int b : succ[a]) height[a] = std::max(height[a], height[b] + 1);
+        longestChain = std::max(longestChain, height[a]);
+    }
+    int cap = std::max(creditCap, 1);
+    result.lowerBound = std::max(longestChain, (result.totalCredits + cap - 1) / cap);
+
+    // Greedy list scheduling: longest remaining chain first, then heavier courses
+    std::vector<int> ready;
+    deg = indeg;
+    for (int a = 0; a < m; a++) if (deg[a] == 0) ready.push_back(a);
+    int scheduled = 0;
+    while (scheduled < m) {
+        std::sort(ready.begin(), ready.end(), [&](int x, int y) {
+            if (height[x] != height[y]) return height[x] > height[y];
+            if (credits[x] != credits[y]) return credits[x] > credits[y];
+            return x < y;
+        });
+        std::vector<int> semester, deferred;
+        int load = 0;
+        for (int a : ready) {
+            if (load + credits[a] <= creditCap) {
+                semester.push_back(a);
+                load += credits[a];
+            } else {
+                deferred.push_back(a);
+            }
+        }
+        for (int a : semester) {
+            for (int b : succ[a]) if (--deg[b] == 0) deferred.push_back(b);
+        }
+        scheduled += static_cast<int>(semester.size());
+        result.semesters.push_back(semester);
+        ready.swap(deferred);
+    }
+    result.feasible = true;
+    result.optimal = static_cast<int>(result.semesters.size()) == result.lowerBound;
+
+    if (!result.optimal && timeBudgetMs > 0 && m <= MAX_SEARCH_COURSES) {
+        std::vector<unsigned long long> predMask(m, 0ULL);
+        for (int a = 0; a < m; a++)
+            for (int b : succ[a]) predMask[b] |= 1ULL << a;
+        searchOptimal(credits, predMask, height, creditCap, timeBudgetMs, result);
+    }
+
+    for (auto& semester : result.semesters) {
+        for (int& a : semester) a = ids[a];
+        std::sort(semester.begin(), semester.end());
+    }
+    return result;
+}
+
+bool SemesterPlanner::searchOptimal(const std::vector<int>& credits, const std::vector<unsigned long long>& predMask,
+    const std::vector<int>& height, int creditCap, int timeBudgetMs, Plan& result) const {
+    typedef unsigned long long Mask;
+    int m = static_cast<int>(credits.size());
+    Mask full = (m == 64) ? ~0ULL : ((1ULL << m) - 1);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeBudgetMs);
+
+    int best = static_cast<int>(result.semesters.size());
+    std::vector<std::vector<int>> path, bestPath;
+    std::unordered_map<Mask, int> seen;
+    long long nodes = 0;
+    bool timedOut = false;
+    int cap = std::max(creditCap, 1);
+
+    std::function<void(Mask, int)> dfs;
+    std::function<void(const std::vector<int>&, size_t, Mask, Mask, int, std::vector<int>&, int)> pick;
+
+    dfs = [&](Mask done, int depth) {
+        if (timedOut) return;
+        if ((++nodes & 1023) == 0 && std::chrono::steady_clock::now() > deadline) {
+            timedOut = true;
+            return;
+        }
+        if (done == full) {
+            if (depth < best) {
+                best = depth;
+                bestPath = path;
+            }
+            return;
+        }
+        auto it = seen.find(done);
+        if (it != seen.end() && it->second <= depth) return;
+        seen[done] = depth;
+
+        int remainingCredits = 0, remainingChain = 0;
+        std::vector<int> ready;
+        for (int a = 0; a < m; a++) {
+            if (done & (1ULL << a)) continue;
+            remainingCredits += credits[a];
+            remainingChain = std::max(remainingChain, height[a]);
+            if ((predMask[a] & done) == predMask[a]) ready.push_back(a);
+        }
+        if (depth + std::max(remainingChain, (remainingCredits + cap - 1) / cap) >= best) return;
+
+        std::sort(ready.begin(), ready.end(), [&](int x, int y) { return height[x] > height[y]; });
+        std::vector<int> chosen;
+        pick(ready, 0, done, 0ULL, 0, chosen, depth);
+    };
+
+    // Only maximal semesters are tried: taking an available course earlier never hurts
+    pick = [&](const std::vector<int>& ready, size_t k, Mask done, Mask taken, int load,
+        std::vector<int>& chosen, int depth) {
+        if (timedOut) return;
+        if (k == ready.size()) {
+            if (chosen.empty()) return;
+            for (int a : ready) {
+                if (!(taken & (1ULL << a)) && load + credits[a] <= creditCap) return;
+            }
+            path.push_back(chosen);
+            dfs(done | taken, depth + 1);
+            path.pop_back();
+            return;
+        }
+        int a = ready[k];
+        if (load + credits[a] <= creditCap) {
+            chosen.push_back(a);
+            pick(ready, k + 1, done, taken | (1ULL << a), load + credits[a], chosen, depth);
+            chosen.pop_back();
+        }
+        pick(ready, k + 1, done, taken, load, chosen, depth);
+    };
+
+    dfs(0ULL, 0);
+
+    if (!bestPath.empty()) result.semesters = bestPath;
+    result.optimal = !timedOut || static_cast<int>(result.semesters.size()) == result.lowerBound;
+    return result.optimal;
+}
+
+std::vector<SemesterPlanner::Plan> SemesterPlanner::planCohort(PeopleManager& pm, const std::vector<int>& targets,
+    int creditCap, int timeBudgetMs, int threads) const {
+    int count = pm.getStudentCount();
+    std::vector<Plan> plans(count);
+    int n = std::max(cm.count(), relations.getSize());
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max(1, std::min(threads, count));
+
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+        while (true) {
+            int s = next.fetch_add(1);
+            if (s >= count) break;
+            std::vector<bool> completed(n, false);
+            const auto* student = pm.getStudent(s);
+            if (student) {
+                for (int c : student->completed) {
+                    if (c >= 0 && c < n) completed[c] = true;
+                }
+            }
+            plans[s] = plan(targets, completed, creditCap, timeBudgetMs);
+            plans[s].studentId = s;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.push_back(std::thread(worker));
+    worker();
+    for (auto& w : workers) w.join();
+    return plans;
+}
+
+void SemesterPlanner::displayPlan(const Plan& p) const {
+    std::cout << "\n" << std::string(60, '=') << "\n DEGREE PLAN\n" << std::string(60, '=') << "\n\n";
+    if (!p.feasible) {
+        std::cout << "[ERROR] No valid plan: " << p.reason << "\n";
+        return;
+    }
+    for (size_t i = 0; i < p.semesters.size(); i++) {
+        int load = 0;
+        std::cout << "Semester " << (i + 1) << ": ";
+        for (size_t j = 0; j < p.semesters[i].size(); j++) {
+            const auto* c = cm.getCourse(p.semesters[i][j]);
+            std::cout << (c ? c->code : std::to_string(p.semesters[i][j]));
+            if (j < p.semesters[i].size() - 1) std::cout << ", ";
+            load += creditsOf(p.semesters[i][j]);
+        }
+        std::cout << " (" << load << " credits)\n";
+    }
+    std::cout << "\nSemesters: " << p.semesters.size() << " (lower bound " << p.lowerBound << ")"
+        << (p.optimal ? " [OPTIMAL]" : "") << "\n";
+    std::cout << "Total Credits: " << p.totalCredits << "\n";
+}
+
 bool Induction::dfsCheck(int courseId, const std::vector<bool>& completed,
     std::vector<bool>& visited, const std::vector<std::vector<bool>>& prereq) const {
     if (courseId >= 0 && courseId < (int)completed.size() && completed[courseId]) return true;
@@ -80,12 +561,14 @@ bool Induction::dfsCheck(int courseId, const std::vector<bool>& completed,
 Induction::Induction(const Relations& r) : relations(r) {}
 
 bool Induction::checkRecursive(int courseId, const std::vector<bool>& completed) const {
+    if (relations.hasRequirement(courseId)) return relations.isEligible(courseId, completed);
     auto prereq = relations.getPrereqMatrix();
     std::vector<bool> visited(prereq.size(), false);
     return dfsCheck(courseId, completed, visited, prereq);
 }
 
 bool Induction::checkStrong(int courseId, const std::vector<bool>& completed) const {
+    if (relations.hasRequirement(courseId)) return relations.isEligible(courseId, completed);
     auto closure = relations.closurePrereq();
     for (int i = 0; i < (int)closure.size(); i++) {
         if (closure[i][courseId] && !completed[i]) return false;
@@ -118,46 +601,165 @@ void Induction::displayCheck(const CourseManager& cm, int courseId, const std::v
     }
     std::cout << "\n\n";
 
-    bool rec = checkRecursive(courseId, completed);
+    // A completed equivalent or cross-listed course counts as done
+    std::vector<bool> satisfied = relations.satisfiedCourses(completed);
+
+    bool rec = checkRecursive(courseId, satisfied);
     std::cout << "RECURSIVE INDUCTION: " << (rec ? "[PASS]" : "[FAIL]") << "\n";
-    bool strong = checkStrong(courseId, completed);
+    bool strong = checkStrong(courseId, satisfied);
     std::cout << "STRONG INDUCTION: " << (strong ? "[PASS]" : "[FAIL]") << "\n";
 
+    auto code = [&](int id) {
+        const auto* pc = cm.getCourse(id);
+        return pc ? pc->code : std::to_string(id);
+    };
+
+    // Courses reached only through a satisfied course are not needed, and
+    // missing ones are told apart by whether they can be taken now
+    auto why = relations.explainMissing(courseId, satisfied);
+    std::vector<bool> needed(satisfied.size(), false), next(satisfied.size(), false);
+    for (int id : why.missing) needed[id] = true;
+    for (int id : why.frontier) next[id] = true;
+
+    // A compiled requirement replaces the plain prerequisite edges
+    if (relations.hasRequirement(courseId)) relations.getRequirements().display(courseId, cm, satisfied);
+
     auto indirect = listIndirect(courseId);
     if (!indirect.empty()) {
         std::cout << "\n--- All Prerequisites (Direct + Indirect) ---\n";
         for (int id : indirect) {
-            const auto* pc = cm.getCourse(id);
-            std::cout << (pc ? pc->code : std::to_string(id)) << " ";
-            std::cout << (completed[id] ? "[DONE]" : "[MISSING]") << "\n";
+            bool done = id < (int)completed.size() && completed[id];
+            std::cout << code(id) << " ";
+            if (done) std::cout << "[DONE]\n";
+            else if (satisfied[id]) std::cout << "[DONE VIA EQUIVALENT]\n";
+            else if (next[id]) std::cout << "[MISSING - TAKE NEXT]\n";
+            else if (needed[id]) std::cout << "[MISSING]\n";
+            else std::cout << "[NOT NEEDED - COVERED BY A COMPLETED COURSE]\n";
+        }
+    }
+
+    if (!why.eligible) {
+        std::cout << "\n--- Take Next (" << why.frontier.size() << " of " << why.missing.size() << " missing) ---\n";
+        for (int id : why.frontier) std::cout << code(id) << " ";
+        if (why.frontier.empty()) {
+            std::cout << (why.satisfiable ? "None: the missing courses form a prerequisite cycle"
+                : "None: a requirement cannot be met by taking more courses");
+        }
+        std::cout << "\n";
+        if (!why.path.empty()) {
+            std::cout << "\n--- Shortest Remaining Path ---\n";
+            for (size_t i = 0; i < why.path.size(); i++) std::cout << (i ? " -> " : "") << code(why.path[i]);
+            std::cout << "\n";
         }
     }
     std::cout << "\n";
 }
 
-void StudentGroupModule::generateCombinations(int start, int k, std::vector<std::string>& current) {
-    if ((int)current.size() == k) {
-        groups.push_back(current);
+StudentGroupModule::CombinationIterator::CombinationIterator(int n, int k) : n(n), k(k), done(k < 0 || k > n) {
+    if (!done) {
+        idx.resize(k);
+        for (int i = 0; i < k; i++) idx[i] = i;
+    }
+}
+
+bool StudentGroupModule::CombinationIterator::valid() const { return !done; }
+
+const std::vector<int>& StudentGroupModule::CombinationIterator::current() const { return idx; }
+
+void StudentGroupModule::CombinationIterator::next() {
+    if (done) return;
+    int i = k - 1;
+    while (i >= 0 && idx[i] == n - k + i) i--;
+    if (i < 0) {
+        done = true;
         return;
     }
-    for (int i = start; i < (int)students.size(); i++) {
-        current.push_back(students[i]);
-        generateCombinations(i + 1, k, current);
-        current.pop_back();
+    idx[i]++;
+    for (int j = i + 1; j < k; j++) idx[j] = idx[j - 1] + 1;
+}
+
+bool StudentGroupModule::CombinationIterator::seek(long long r) {
+    if (k < 0 || k > n || r < 0 || r >= StudentGroupModule::nCr(n, k)) {
+        done = true;
+        return false;
+    }
+    // Combinadic unranking: at each slot skip whole blocks of C(n-c-1, k-j-1)
+    idx.assign(k, 0);
+    int c = 0;
+    for (int j = 0; j < k; j++) {
+        while (true) {
+            long long block = StudentGroupModule::nCr(n - c - 1, k - j - 1);
+            if (r < block) break;
+            r -= block;
+            c++;
+        }
+        idx[j] = c++;
+    }
+    done = false;
+    return true;
+}
+
+long long StudentGroupModule::CombinationIterator::rank() const {
+    if (done) return -1;
+    long long r = 0;
+    int c = 0;
+    for (int j = 0; j < k; j++) {
+        for (; c < idx[j]; c++) r += StudentGroupModule::nCr(n - c - 1, k - j - 1);
+        c = idx[j] + 1;
     }
+    return r;
 }
 
-long long StudentGroupModule::nCr(int n, int r) const {
+long long StudentGroupModule::nCr(int n, int r) {
     if (r > n || r < 0) return 0;
-    if (r == 0 || r == n) return 1;
+    r = std::min(r, n - r);
+    // result * (n - i) / (i + 1) is integral; cancel the gcd first so nothing overflows early
     long long result = 1;
     for (int i = 0; i < r; i++) {
-        result *= (n - i);
-        result /= (i + 1);
+        long long num = n - i, den = i + 1;
+        long long g = std::gcd(result, den);
+        result /= g;
+        den /= g;
+        num /= den;
+        if (result > LLONG_MAX / num) return LLONG_MAX;
+        result *= num;
     }
     return result;
 }
 
+std::string StudentGroupModule::nCrExact(int n, int r) {
+    if (r > n || r < 0) return "0";
+    r = std::min(r, n - r);
+    // Little-endian base 1e9 limbs; each division by (i + 1) is exact
+    const unsigned long long BASE = 1000000000ULL;
+    std::vector<unsigned long long> limbs(1, 1);
+    for (int i = 0; i < r; i++) {
+        unsigned long long carry = 0;
+        for (auto& limb : limbs) {
+            unsigned long long v = limb * static_cast<unsigned long long>(n - i) + carry;
+            limb = v % BASE;
+            carry = v / BASE;
+        }
+        while (carry) {
+            limbs.push_back(carry % BASE);
+            carry /= BASE;
+        }
+        unsigned long long rem = 0;
+        for (size_t j = limbs.size(); j-- > 0;) {
+            unsigned long long v = limbs[j] + rem * BASE;
+            limbs[j] = v / (i + 1);
+            rem = v % (i + 1);
+        }
+        while (limbs.size() > 1 && limbs.back() == 0) limbs.pop_back();
+    }
+    std::string out = std::to_string(limbs.back());
+    for (size_t j = limbs.size() - 1; j-- > 0;) {
+        std::string part = std::to_string(limbs[j]);
+        out += std::string(9 - part.size(), '0') + part;
+    }
+    return out;
+}
+
 bool StudentGroupModule::addStudent(const std::string& name) {
     if (std::find(students.begin(), students.end(), name) != students.end()) {
         std::cout << "[WARNING] Student already exists!\n";
@@ -176,28 +778,224 @@ void StudentGroupModule::display() const {
     std::cout << "\nTotal: " << students.size() << "\n";
 }
 
-void StudentGroupModule::displayCombinations(int groupSize) {
+void StudentGroupModule::displayCombinations(int groupSize, int maxDisplay) const {
     std::cout << "\n" << std::string(60, '=') << "\n GROUP COMBINATIONS\n" << std::string(60, '=') << "\n\n";
     if (groupSize <= 0 || groupSize > (int)students.size()) {
         std::cout << "[ERROR] Invalid group size!\n";
         return;
     }
-    groups.clear();
-    std::vector<std::string> current;
-    generateCombinations(0, groupSize, current);
+    long long total = nCr(students.size(), groupSize);
+    std::string exact = nCrExact(students.size(), groupSize);
     std::cout << "\nGroup Size: " << groupSize << "\n";
-    std::cout << "Total Combinations: " << groups.size() << "\n";
-    std::cout << "Formula: C(" << students.size() << "," << groupSize << ") = " << nCr(students.size(), groupSize) << "\n\n";
-    int display = std::min(30, (int)groups.size());
-    for (int i = 0; i < display; i++) {
-        std::cout << "Group #" << (i + 1) << ": ";
-        for (size_t j = 0; j < groups[i].size(); j++) {
-            std::cout << groups[i][j];
-            if (j < groups[i].size() - 1) std::cout << ", ";
+    std::cout << "Total Combinations: " << exact << "\n";
+    std::cout << "Formula: C(" << students.size() << "," << groupSize << ") = " << exact << "\n\n";
+    int shown = 0;
+    for (CombinationIterator it = combinations(groupSize); it.valid() && shown < maxDisplay; it.next()) {
+        const std::vector<int>& g = it.current();
+        std::cout << "Group #" << (++shown) << ": ";
+        for (size_t j = 0; j < g.size(); j++) {
+            std::cout << students[g[j]];
+            if (j < g.size() - 1) std::cout << ", ";
+        }
+        std::cout << "\n";
+    }
+    if (total == LLONG_MAX) {
+        std::cout << "\n... and more (count exceeds 64-bit range)\n";
+    } else if (total > shown) {
+        std::cout << "\n... and " << (total - shown) << " more\n";
+    }
+}
+
+StudentGroupModule::CombinationIterator StudentGroupModule::combinations(int groupSize) const {
+    return CombinationIterator(students.size(), groupSize);
+}
+
+bool StudentGroupModule::groupAt(int groupSize, long long rank, std::vector<std::string>& group) const {
+    CombinationIterator it(students.size(), groupSize);
+    if (!it.seek(rank)) return false;
+    group.clear();
+    for (int i : it.current()) group.push_back(students[i]);
+    return true;
+}
+
+GroupFormation::GroupFormation(PeopleManager& pm) : courseCount(0) {
+    for (int i = 0; i < pm.getStudentCount(); i++) {
+        const auto* s = pm.getStudent(i);
+        if (!s) continue;
+        std::vector<int> profile;
+        for (int c : s->enrolled) {
+            if (c >= 0) profile.push_back(c);
+        }
+        std::sort(profile.begin(), profile.end());
+        profile.erase(std::unique(profile.begin(), profile.end()), profile.end());
+        if (!profile.empty()) courseCount = std::max(courseCount, profile.back() + 1);
+        studentIds.push_back(s->id);
+        profiles.push_back(profile);
+    }
+}
+
+GroupFormation::Result GroupFormation::runOnce(int groupCount, unsigned seed,
+    std::chrono::steady_clock::time_point deadline) const {
+    int n = static_cast<int>(profiles.size());
+    int C = std::max(courseCount, 1);
+    std::mt19937 rng(seed);
+
+    // Sizes differ by at most one: the first n % G groups take the extra member
+    std::vector<int> room(groupCount, n / groupCount);
+    for (int g = 0; g < n % groupCount; g++) room[g]++;
+
+    std::vector<int> count(static_cast<size_t>(groupCount) * C, 0);
+    std::vector<int> groupOf(n, -1);
+    Result r;
+    r.cost = 0;
+    r.restarts = 1;
+    r.swaps = 0;
+
+    // Greedy seed: heaviest profiles first, each into the open group it overlaps least
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return profiles[a].size() > profiles[b].size();
+    });
+    std::vector<int> open(groupCount);
+    for (int g = 0; g < groupCount; g++) open[g] = g;
+    const int SAMPLE = 48;
+    for (int s : order) {
+        int bestSlot = -1;
+        long long bestAdd = 0;
+        int tries = std::min(static_cast<int>(open.size()), SAMPLE);
+        for (int t = 0; t < tries; t++) {
+            int slot = (static_cast<int>(open.size()) <= SAMPLE) ? t : static_cast<int>(rng() % open.size());
+            int g = open[slot];
+            long long add = 0;
+            for (int c : profiles[s]) add += count[static_cast<size_t>(g) * C + c];
+            if (bestSlot < 0 || add < bestAdd || (add == bestAdd && room[g] > room[open[bestSlot]])) {
+                bestSlot = slot;
+                bestAdd = add;
+            }
+        }
+        int g = open[bestSlot];
+        groupOf[s] = g;
+        r.cost += bestAdd;
+        for (int c : profiles[s]) count[static_cast<size_t>(g) * C + c]++;
+        if (--room[g] == 0) {
+            open[bestSlot] = open.back();
+            open.pop_back();
+        }
+    }
+    r.seedCost = r.cost;
+
+    // Swap search. Shared courses of the pair cancel, hence the mark arrays
+    std::vector<int> markA(C, -1), markB(C, -1);
+    long long stall = 0, stallLimit = 50LL * n + 1000;
+    for (long long iter = 0; r.cost > 0 && stall < stallLimit && n > 1; iter++) {
+        if ((iter & 255) == 0 && std::chrono::steady_clock::now() >= deadline) break;
+        int a = rng() % n, b = rng() % n;
+        int ga = groupOf[a], gb = groupOf[b];
+        if (ga == gb) {
+            stall++;
+            continue;
+        }
+        const int* ca = &count[static_cast<size_t>(ga) * C];
+        const int* cb = &count[static_cast<size_t>(gb) * C];
+        for (int c : profiles[a]) markA[c] = static_cast<int>(iter);
+        for (int c : profiles[b]) markB[c] = static_cast<int>(iter);
+        long long delta = 0;
+        for (int c : profiles[a]) {
+            if (markB[c] == static_cast<int>(iter)) continue;
+            delta += cb[c] - (ca[c] - 1);
+        }
+        for (int c : profiles[b]) {
+            if (markA[c] == static_cast<int>(iter)) continue;
+            delta += ca[c] - (cb[c] - 1);
+        }
+        // Sideways moves now and then keep the search off plateaus
+        if (delta < 0 || (delta == 0 && rng() % 8 == 0)) {
+            for (int c : profiles[a]) {
+                count[static_cast<size_t>(ga) * C + c]--;
+                count[static_cast<size_t>(gb) * C + c]++;
+            }
+            for (int c : profiles[b]) {
+                count[static_cast<size_t>(gb) * C + c]--;
+                count[static_cast<size_t>(ga) * C + c]++;
+            }
+            groupOf[a] = gb;
+            groupOf[b] = ga;
+            r.cost += delta;
+            r.swaps++;
+            stall = (delta < 0) ? 0 : stall + 1;
+        } else {
+            stall++;
+        }
+    }
+
+    r.groups.assign(groupCount, std::vector<int>());
+    for (int s = 0; s < n; s++) r.groups[groupOf[s]].push_back(studentIds[s]);
+    return r;
+}
+
+GroupFormation::Result GroupFormation::form(int groupSize, int timeBudgetMs, int threads, unsigned seed) const {
+    Result best;
+    best.cost = 0;
+    best.seedCost = 0;
+    best.restarts = 0;
+    best.swaps = 0;
+    int n = static_cast<int>(profiles.size());
+    if (groupSize <= 0 || n == 0) return best;
+
+    int groupCount = (n + groupSize - 1) / groupSize;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeBudgetMs, 0));
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::mutex bestMutex;
+    bool haveBest = false;
+    int restarts = 0;
+    auto worker = [&](int t) {
+        Result local;
+        bool haveLocal = false;
+        int runs = 0;
+        // Every thread finishes at least one run, even on a zero budget
+        do {
+            Result r = runOnce(groupCount, seed + 7919u * t + 104729u * runs, deadline);
+            runs++;
+            if (!haveLocal || r.cost < local.cost) {
+                local = r;
+                haveLocal = true;
+            }
+        } while (local.cost > 0 && std::chrono::steady_clock::now() < deadline);
+        std::lock_guard<std::mutex> lock(bestMutex);
+        restarts += runs;
+        if (!haveBest || local.cost < best.cost) {
+            best = local;
+            haveBest = true;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.push_back(std::thread(worker, t));
+    worker(0);
+    for (auto& w : workers) w.join();
+    best.restarts = restarts;
+    return best;
+}
+
+void GroupFormation::displayGroups(const Result& r, PeopleManager& pm, int maxDisplay) const {
+    std::cout << "\n" << std::string(60, '=') << "\n PROJECT GROUPS\n" << std::string(60, '=') << "\n\n";
+    int display = std::min(maxDisplay, static_cast<int>(r.groups.size()));
+    for (int g = 0; g < display; g++) {
+        std::cout << "Group #" << (g + 1) << ": ";
+        for (size_t j = 0; j < r.groups[g].size(); j++) {
+            const auto* s = pm.getStudent(r.groups[g][j]);
+            std::cout << (s ? s->name : std::to_string(r.groups[g][j]));
+            if (j < r.groups[g].size() - 1) std::cout << ", ";
         }
         std::cout << "\n";
     }
-    if ((int)groups.size() > 30) {
-        std::cout << "\n... and " << (groups.size() - 30) << " more\n";
+    if (static_cast<int>(r.groups.size()) > display) {
+        std::cout << "\n... and " << (r.groups.size() - display) << " more\n";
     }
+    std::cout << "\nGroups: " << r.groups.size() << "\n";
+    std::cout << "Shared-course pairs: " << r.cost << " (greedy seed " << r.seedCost << ")\n";
+    std::cout << "Restarts: " << r.restarts << ", swaps: " << r.swaps << "\n";
 }
\ No newline at end of file
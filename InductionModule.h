@@ -3,22 +3,65 @@
 
 #include <vector>
 #include <string>
+#include <functional>
+#include <chrono>
 
 class Relations;
 class CourseManager;
 
 class Scheduling {
+public:
+    // Receives each complete order; return false to stop the enumeration
+    typedef std::function<bool(const std::vector<int>&)> OrderVisitor;
+    static const int MAX_COUNT_COURSES = 20;
 private:
     const Relations& relations;
     std::vector<std::vector<int>> validOrders;
-    void backtrack(const std::vector<std::vector<bool>>&, std::vector<bool>&, std::vector<int>&, int, int);
+    void buildGraph(int, std::vector<std::vector<int>>&, std::vector<int>&) const;
 public:
     Scheduling(const Relations&);
     int generateOrders(int, int limit = 500);
-    void displayOrders(const CourseManager&, int maxDisplay = 20) const;
+    long long forEachOrder(int, const OrderVisitor&, long long limit = -1, int threads = 1) const;
+    long long countOrders(int) const;
+    // Sequences first.. first+maxDisplay-1
+    void displayOrders(const CourseManager&, int maxDisplay = 20, int first = 0) const;
     const std::vector<std::vector<int>>& getOrders() const;
 };
 
+class PeopleManager;
+
+// Builds minimum-semester degree plans from the prerequisite DAG under a
+// per-semester credit cap. Greedy list scheduling by critical path, with an
+// optional branch-and-bound search run until a time budget expires.
+class SemesterPlanner {
+public:
+    struct Plan {
+        int studentId;
+        std::vector<std::vector<int>> semesters;
+        int totalCredits;
+        int lowerBound;
+        bool feasible;
+        bool optimal;
+        std::string reason;
+    };
+    static const int MAX_SEARCH_COURSES = 64;
+private:
+    const Relations& relations;
+    const CourseManager& cm;
+    int creditsOf(int) const;
+    bool searchOptimal(const std::vector<int>&, const std::vector<unsigned long long>&,
+        const std::vector<int>&, int, int, Plan&) const;
+public:
+    SemesterPlanner(const Relations&, const CourseManager&);
+    std::vector<int> longestPathLayers() const;
+    std::vector<int> criticalPathLengths() const;
+    Plan plan(const std::vector<int>& targets, const std::vector<bool>& completed,
+        int creditCap, int timeBudgetMs = 0) const;
+    std::vector<Plan> planCohort(PeopleManager&, const std::vector<int>& targets,
+        int creditCap, int timeBudgetMs = 0, int threads = 0) const;
+    void displayPlan(const Plan&) const;
+};
+
 class Induction {
 private:
     const Relations& relations;
@@ -32,15 +75,58 @@ public:
 };
 
 class StudentGroupModule {
+public:
+    // Walks k-subsets of [0, n) in lexicographic order as index arrays.
+    // next() is amortized O(1); seek() jumps straight to a rank.
+    class CombinationIterator {
+    private:
+        int n;
+        int k;
+        std::vector<int> idx;
+        bool done;
+    public:
+        CombinationIterator(int n, int k);
+        bool valid() const;
+        const std::vector<int>& current() const;
+        void next();
+        bool seek(long long rank);
+        long long rank() const;
+    };
 private:
     std::vector<std::string> students;
-    std::vector<std::vector<std::string>> groups;
-    void generateCombinations(int, int, std::vector<std::string>&);
-    long long nCr(int, int) const;
 public:
     bool addStudent(const std::string&);
     void display() const;
-    void displayCombinations(int);
+    void displayCombinations(int, int maxDisplay = 30) const;
+    CombinationIterator combinations(int) const;
+    bool groupAt(int, long long, std::vector<std::string>&) const;
+    // Saturates at LLONG_MAX; nCrExact gives the full decimal value
+    static long long nCr(int, int);
+    static std::string nCrExact(int, int);
+};
+
+// Splits a whole class into balanced project groups (sizes differ by at most
+// one) that mix enrolled-course profiles. The cost is the number of member
+// pairs sharing a course. A greedy seed is improved by student swaps with
+// incremental cost deltas, restarted on several threads until the deadline.
+class GroupFormation {
+public:
+    struct Result {
+        std::vector<std::vector<int>> groups;
+        long long cost;
+        long long seedCost;
+        int restarts;
+        long long swaps;
+    };
+private:
+    std::vector<int> studentIds;
+    std::vector<std::vector<int>> profiles;
+    int courseCount;
+    Result runOnce(int, unsigned, std::chrono::steady_clock::time_point) const;
+public:
+    GroupFormation(PeopleManager&);
+    Result form(int groupSize, int timeBudgetMs = 500, int threads = 0, unsigned seed = 1) const;
+    void displayGroups(const Result&, PeopleManager&, int maxDisplay = 20) const;
 };
 
 #endif#pragma once
@@ -1,49 +1,349 @@
 #include "LogicEngine.h"
+#include "SetOperations.h"
+#include <deque>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <vector>
 #include <string>
 
+int LogicEngine::intern(const std::string& name) {
+    auto it = atomIds.find(name);
+    if (it != atomIds.end()) return it->second;
+
+    int atom = (int)atomNames.size();
+    atomIds.emplace(name, atom);
+    atomNames.push_back(name);
+    atomCourse.push_back(-1);
+    watchers.emplace_back();
+    size_t words = (atomNames.size() + 63) / 64;
+    truth.resize(words, 0ULL);
+    assigned.resize(words, 0ULL);
+    asserted.resize(words, 0ULL);
+    return atom;
+}
+
+// Course c is the atom "course_c"; the name is only built the first time
+int LogicEngine::courseAtom(int courseId) {
+    if (courseId < 0) return intern("course_" + std::to_string(courseId));
+    if (courseId >= (int)courseAtoms.size()) courseAtoms.resize(courseId + 1, -1);
+    if (courseAtoms[courseId] < 0) {
+        int atom = intern("course_" + std::to_string(courseId));
+        courseAtoms[courseId] = atom;
+        atomCourse[atom] = courseId;
+    }
+    return courseAtoms[courseId];
+}
+
+int LogicEngine::findCourseAtom(int courseId) const {
+    if (courseId >= 0 && courseId < (int)courseAtoms.size()) return courseAtoms[courseId];
+    return -1;
+}
+
+bool LogicEngine::testBit(const std::vector<unsigned long long>& bits, int atom) {
+    return (bits[atom / 64] >> (atom % 64)) & 1ULL;
+}
+
+void LogicEngine::setBit(std::vector<unsigned long long>& bits, int atom, bool value) {
+    if (value) bits[atom / 64] |= 1ULL << (atom % 64);
+    else bits[atom / 64] &= ~(1ULL << (atom % 64));
+}
+
+void LogicEngine::makeTrue(int atom) {
+    setBit(truth, atom, true);
+    setBit(assigned, atom, true);
+    for (int r : watchers[atom]) {
+        if (--compiled[r].unmet == 0) ready.push_back(r);
+    }
+}
+
+// After a retraction derived facts may no longer hold: keep only what was
+// asserted and count again from scratch. Returns the facts true before.
+std::vector<unsigned long long> LogicEngine::recount() {
+    std::vector<unsigned long long> before = truth;
+    for (size_t w = 0; w < truth.size(); w++) {
+        assigned[w] &= ~(truth[w] & ~asserted[w]);
+        truth[w] &= asserted[w];
+    }
+    ready.clear();
+    for (int r = 0; r < (int)compiled.size(); r++) {
+        compiled[r].unmet = 0;
+        for (int a : compiled[r].antecedent) {
+            if (!testBit(truth, a)) compiled[r].unmet++;
+        }
+        if (compiled[r].unmet == 0) ready.push_back(r);
+    }
+    stale = false;
+    return before;
+}
+
 void LogicEngine::addRule(const std::string& name, const std::vector<int>& ante,
     const std::vector<int>& cons, const std::string& desc) {
     rules.push_back({ name, ante, cons, desc });
+
+    CompiledRule rule;
+    for (int c : ante) rule.antecedent.push_back(courseAtom(c));
+    for (int c : cons) rule.consequent.push_back(courseAtom(c));
+    std::sort(rule.antecedent.begin(), rule.antecedent.end());
+    rule.antecedent.erase(std::unique(rule.antecedent.begin(), rule.antecedent.end()), rule.antecedent.end());
+
+    rule.unmet = 0;
+    int r = (int)compiled.size();
+    for (int a : rule.antecedent) {
+        watchers[a].push_back(r);
+        if (!testBit(truth, a)) rule.unmet++;
+    }
+    compiled.push_back(rule);
+    if (rule.unmet == 0) ready.push_back(r);
+
     std::cout << "[SUCCESS] Added rule: " << name << "\n";
 }
 
 void LogicEngine::addFact(const std::string& fact, bool value) {
-    facts.insert(fact, value);
+    int atom = intern(fact);
+    setBit(asserted, atom, value);
+    if (value) {
+        if (!testBit(truth, atom)) makeTrue(atom);
+    }
+    else {
+        bool wasTrue = testBit(truth, atom);
+        setBit(truth, atom, false);
+        setBit(assigned, atom, true);
+        if (wasTrue) stale = true;
+    }
+}
+
+bool LogicEngine::isTrue(const std::string& fact) const {
+    auto it = atomIds.find(fact);
+    return it != atomIds.end() && testBit(truth, it->second);
 }
 
 bool LogicEngine::checkRule(const Rule& rule) const {
     for (int a : rule.antecedent) {
-        std::string key = "course_" + std::to_string(a);
-        const bool* val = facts.get(key);
-        if (!val || !(*val)) return false;
+        int atom = findCourseAtom(a);
+        if (atom < 0 || !testBit(truth, atom)) return false;
     }
     return true;
 }
 
 std::vector<std::string> LogicEngine::inferConsequences() {
+    bool rebuilt = stale;
+    std::vector<unsigned long long> before;
+    if (stale) before = recount();
+
     std::vector<std::string> inferred;
-    bool changed = true;
-    while (changed) {
-        changed = false;
-        for (const auto& rule : rules) {
-            if (checkRule(rule)) {
-                for (int c : rule.consequent) {
-                    std::string key = "course_" + std::to_string(c);
-                    const bool* val = facts.get(key);
-                    if (!val || !(*val)) {
-                        facts.insert(key, true);
-                        inferred.push_back("Inferred: " + rule.description);
-                        changed = true;
+    while (!ready.empty()) {
+        int r = ready.back();
+        ready.pop_back();
+        for (int c : compiled[r].consequent) {
+            if (!testBit(truth, c)) {
+                makeTrue(c);
+                if (!rebuilt || !testBit(before, c)) inferred.push_back("Inferred: " + rules[r].description);
+            }
+        }
+    }
+    return inferred;
+}
+
+std::vector<int> LogicEngine::deriveCourses(const std::vector<int>& completed) const {
+    std::vector<int> unmet(compiled.size());
+    for (size_t r = 0; r < compiled.size(); r++) unmet[r] = (int)compiled[r].antecedent.size();
+
+    std::vector<unsigned long long> known((atomNames.size() + 63) / 64, 0ULL);
+    std::vector<int> queue;
+    std::vector<int> result;
+    for (size_t r = 0; r < compiled.size(); r++) {
+        if (unmet[r] == 0) queue.push_back((int)r);
+    }
+
+    auto learn = [&](int atom) {
+        setBit(known, atom, true);
+        for (int r : watchers[atom]) {
+            if (--unmet[r] == 0) queue.push_back(r);
+        }
+    };
+
+    for (int c : completed) {
+        int atom = findCourseAtom(c);
+        if (atom >= 0 && !testBit(known, atom)) learn(atom);
+    }
+
+    while (!queue.empty()) {
+        int r = queue.back();
+        queue.pop_back();
+        for (int atom : compiled[r].consequent) {
+            if (testBit(known, atom)) continue;
+            learn(atom);
+            result.push_back(atomCourse[atom]);
+        }
+    }
+    return result;
+}
+
+int LogicEngine::atomCount() const { return (int)atomNames.size(); }
+
+LogicEngine::FactMatrix::FactMatrix(int studentCount, int atomCount)
+    : students(std::max(0, studentCount)), words((students + 63) / 64),
+      bits((size_t)std::max(0, atomCount) * words, 0ULL) {}
+
+int LogicEngine::FactMatrix::studentCount() const { return students; }
+
+int LogicEngine::FactMatrix::atomCount() const { return words == 0 ? 0 : (int)(bits.size() / words); }
+
+bool LogicEngine::FactMatrix::test(int student, int atom) const {
+    if (student < 0 || student >= students || atom < 0 || atom >= atomCount()) return false;
+    return (row(atom)[student / 64] >> (student % 64)) & 1ULL;
+}
+
+void LogicEngine::FactMatrix::set(int student, int atom) {
+    if (student < 0 || student >= students || atom < 0 || atom >= atomCount()) return;
+    row(atom)[student / 64] |= 1ULL << (student % 64);
+}
+
+int LogicEngine::FactMatrix::count(int atom) const {
+    int total = 0;
+    if (atom < 0 || atom >= atomCount()) return 0;
+    for (int w = 0; w < words; w++) {
+        for (unsigned long long x = row(atom)[w]; x; x &= x - 1) total++;
+    }
+    return total;
+}
+
+// Rules ordered so producers of an atom come before its consumers. With no
+// cycles one pass in this order reaches the fixpoint; rules on a cycle go
+// last and the passes repeat until nothing changes.
+std::vector<int> LogicEngine::batchOrder(bool& acyclic) const {
+    int n = (int)compiled.size();
+    std::vector<int> waiting(n, 0);
+    std::vector<std::vector<int>> producers(atomNames.size());
+    for (int r = 0; r < n; r++)
+        for (int c : compiled[r].consequent) producers[c].push_back(r);
+    for (int r = 0; r < n; r++)
+        for (int a : compiled[r].antecedent) waiting[r] += (int)producers[a].size();
+
+    std::vector<int> order;
+    order.reserve(n);
+    for (int r = 0; r < n; r++)
+        if (waiting[r] == 0) order.push_back(r);
+    for (size_t i = 0; i < order.size(); i++) {
+        for (int c : compiled[order[i]].consequent)
+            for (int next : watchers[c])
+                if (--waiting[next] == 0) order.push_back(next);
+    }
+
+    acyclic = (int)order.size() == n;
+    if (!acyclic) {
+        std::vector<bool> placed(n, false);
+        for (int r : order) placed[r] = true;
+        for (int r = 0; r < n; r++)
+            if (!placed[r]) order.push_back(r);
+    }
+    return order;
+}
+
+LogicEngine::FactMatrix LogicEngine::loadStudents(const std::vector<std::vector<int>>& completed) const {
+    FactMatrix facts((int)completed.size(), (int)atomNames.size());
+    for (int s = 0; s < (int)completed.size(); s++)
+        for (int c : completed[s]) facts.set(s, findCourseAtom(c));
+    return facts;
+}
+
+LogicEngine::FactMatrix LogicEngine::loadStudents(PeopleManager& pm) const {
+    std::vector<std::vector<int>> completed(pm.getStudentCount());
+    for (int s = 0; s < pm.getStudentCount(); s++) {
+        const auto* st = pm.getStudent(s);
+        if (st) completed[s] = st->completed;
+    }
+    return loadStudents(completed);
+}
+
+bool LogicEngine::evaluateAll(FactMatrix& facts, int threads) const {
+    if (facts.words == 0) return true;
+    if (facts.atomCount() < (int)atomNames.size()) return false;
+
+    bool acyclic;
+    std::vector<int> order = batchOrder(acyclic);
+    const int words = facts.words;
+    const unsigned long long tail = facts.students % 64 ? (1ULL << (facts.students % 64)) - 1 : ~0ULL;
+
+    // Chunks of 64 words (4096 students) keep every touched row slice in
+    // cache, and one bit per word marks which words of a rule still need
+    // evaluating. A rule runs again only on the words where one of its
+    // antecedents gained students (semi-naive), starting from dependency order.
+    const int chunkWords = 64;
+    int chunks = (words + chunkWords - 1) / chunkWords;
+    auto runChunk = [&](int chunk) {
+        int begin = chunk * chunkWords;
+        int span = std::min(words - begin, chunkWords);
+        unsigned long long all = span == 64 ? ~0ULL : (1ULL << span) - 1;
+        std::deque<int> work(order.begin(), order.end());
+        std::vector<unsigned long long> pending(compiled.size(), all);
+
+        while (!work.empty()) {
+            int r = work.front();
+            work.pop_front();
+            unsigned long long dirty = pending[r];
+            pending[r] = 0;
+
+            const CompiledRule& rule = compiled[r];
+            for (int c : rule.consequent) {
+                unsigned long long grew = 0;
+                for (unsigned long long m = dirty; m; m &= m - 1) {
+                    int bit = SetOps::lowestBit(m);
+                    int w = begin + bit;
+                    unsigned long long fire = w == words - 1 ? tail : ~0ULL;
+                    for (int a : rule.antecedent) {
+                        fire &= facts.row(a)[w];
+                        if (!fire) break;
                     }
+                    unsigned long long& cell = facts.row(c)[w];
+                    if (fire & ~cell) {
+                        cell |= fire;
+                        grew |= 1ULL << bit;
+                    }
+                }
+                if (!grew || acyclic) continue;
+                for (int next : watchers[c]) {
+                    if (!pending[next]) work.push_back(next);
+                    pending[next] |= grew;
                 }
             }
         }
+    };
+
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, chunks);
+    if (threads <= 1) {
+        for (int c = 0; c < chunks; c++) runChunk(c);
+        return true;
     }
-    return inferred;
+
+    // Chunks cover disjoint words of every row, so workers never share a word
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            for (int c = t; c < chunks; c += threads) runChunk(c);
+        });
+    }
+    for (auto& worker : pool) worker.join();
+    return true;
+}
+
+bool LogicEngine::holds(const FactMatrix& facts, int student, int courseId) const {
+    return facts.test(student, findCourseAtom(courseId));
+}
+
+std::vector<int> LogicEngine::studentsWith(const FactMatrix& facts, int courseId) const {
+    std::vector<int> result;
+    int atom = findCourseAtom(courseId);
+    if (atom < 0 || atom >= facts.atomCount()) return result;
+    const unsigned long long* r = facts.row(atom);
+    for (int w = 0; w < facts.words; w++) {
+        if (!r[w]) continue;
+        for (int bit = 0; bit < 64; bit++)
+            if ((r[w] >> bit) & 1ULL) result.push_back(w * 64 + bit);
+    }
+    return result;
 }
 
 void LogicEngine::displayRules() const {
@@ -66,7 +366,8 @@ void LogicEngine::displayRules() const {
 
 void LogicEngine::displayFacts() const {
     std::cout << "\n" << std::string(60, '=') << "\n CURRENT FACTS\n" << std::string(60, '=') << "\n\n";
-    for (const auto& pair : facts) {
-        std::cout << pair.first << " = " << (pair.second ? "TRUE" : "FALSE") << "\n";
+    for (int atom = 0; atom < (int)atomNames.size(); atom++) {
+        if (!testBit(assigned, atom)) continue;
+        std::cout << atomNames[atom] << " = " << (testBit(truth, atom) ? "TRUE" : "FALSE") << "\n";
     }
 }
\ No newline at end of file
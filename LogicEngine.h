@@ -2,11 +2,14 @@
 #define LOGICENGINE_H
 
 #include "CourseManager.h"
+#include "PeopleManager.h"
 #include <iostream>
 #include <vector>
 #include <string>
 #include <iomanip>
 #include <algorithm>
+#include <unordered_map>
+#include <thread>
 
 class LogicEngine {
 public:
@@ -16,14 +19,82 @@ public:
         std::vector<int> consequent;
         std::string description;
     };
+
+    // Students x atoms for batch evaluation, stored atom-major: word w of
+    // an atom's row holds that fact for students 64w..64w+63, so one AND/OR
+    // evaluates a rule for 64 students.
+    class FactMatrix {
+    private:
+        int students;
+        int words;
+        std::vector<unsigned long long> bits;
+        friend class LogicEngine;
+        unsigned long long* row(int atom) { return bits.data() + (size_t)atom * words; }
+        const unsigned long long* row(int atom) const { return bits.data() + (size_t)atom * words; }
+    public:
+        FactMatrix(int studentCount = 0, int atomCount = 0);
+        int studentCount() const;
+        int atomCount() const;
+        bool test(int student, int atom) const;
+        void set(int student, int atom);
+        int count(int atom) const;
+    };
 private:
+    // Facts are interned atoms with truth kept in bitsets. Rules are compiled
+    // to atom lists, indexed by antecedent atom, and carry a count of
+    // antecedents not yet true. A new fact visits only the rules watching it
+    // and a rule fires when its count reaches zero, so inference reaches the
+    // fixpoint in time proportional to the rules touched.
+    struct CompiledRule {
+        std::vector<int> antecedent;
+        std::vector<int> consequent;
+        int unmet;
+    };
+
     std::vector<Rule> rules;
-    CustomMap<std::string, bool> facts;
+    std::vector<CompiledRule> compiled;
+    std::vector<std::vector<int>> watchers;
+    std::unordered_map<std::string, int> atomIds;
+    std::vector<std::string> atomNames;
+    std::vector<int> courseAtoms;
+    std::vector<int> atomCourse;
+    std::vector<unsigned long long> truth;
+    std::vector<unsigned long long> assigned;
+    std::vector<unsigned long long> asserted;
+    std::vector<int> ready;
+    bool stale = false;
+
+    int intern(const std::string&);
+    int courseAtom(int);
+    int findCourseAtom(int) const;
+    static bool testBit(const std::vector<unsigned long long>&, int);
+    static void setBit(std::vector<unsigned long long>&, int, bool);
+    void makeTrue(int);
+    std::vector<unsigned long long> recount();
+    std::vector<int> batchOrder(bool& acyclic) const;
 public:
     void addRule(const std::string&, const std::vector<int>&, const std::vector<int>&, const std::string&);
     void addFact(const std::string&, bool value = true);
+    bool isTrue(const std::string&) const;
     bool checkRule(const Rule&) const;
+    // Runs to a fixpoint from the facts added since the last call. After a
+    // retraction the fixpoint is rebuilt, but facts that still follow are
+    // not reported again
     std::vector<std::string> inferConsequences();
+    // Fixpoint for one student's completed courses, leaving the engine's own
+    // facts alone; returns the course IDs the rules add
+    std::vector<int> deriveCourses(const std::vector<int>&) const;
+    // Batch mode: one row of facts per student, evaluated to a fixpoint
+    // for all students at once in parallel chunks of student words. Only
+    // courses named by some rule have atoms; holds() is false for the rest.
+    // evaluateAll returns false, leaving the matrix alone, when rules added
+    // since loadStudents() named new courses: reload the students first
+    FactMatrix loadStudents(const std::vector<std::vector<int>>&) const;
+    FactMatrix loadStudents(PeopleManager&) const;
+    bool evaluateAll(FactMatrix&, int threads = 0) const;
+    bool holds(const FactMatrix&, int student, int courseId) const;
+    std::vector<int> studentsWith(const FactMatrix&, int courseId) const;
+    int atomCount() const;
     void displayRules() const;
     void displayFacts() const;
 };
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
 #include <iomanip>
@@ -7,6 +8,28 @@
 #include <cmath>
 #include <fstream>
 #include <ctime>
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <charconv>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#endif
 
 using namespace std;
 
@@ -133,14 +156,70 @@ private:
     vector<unsigned long long> bits;
     int totalBits;
 
+    static int unitsFor(int size) {
+        return (size + BITS_PER_UNIT - 1) / BITS_PER_UNIT;
+    }
+
+    // Bits past totalBits in the last unit are always kept clear
+    void trimTail() {
+        int extra = (int)bits.size() * BITS_PER_UNIT - totalBits;
+        if (extra > 0 && !bits.empty()) {
+            bits.back() &= ~0ULL >> extra;
+        }
+    }
+
 public:
-    CustomBitset(int size = 1000) : totalBits(size) {
-        int units = (size + BITS_PER_UNIT - 1) / BITS_PER_UNIT;
-        bits.resize(units, 0ULL);
+    static int popcount64(unsigned long long x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        return (int)__popcnt64(x);
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    // Index of the lowest set bit, x must be non-zero
+    static int trailingZeros64(unsigned long long x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return (int)index;
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#else
+        return popcount64((x & (~x + 1)) - 1);
+#endif
+    }
+
+    CustomBitset(int size = 0) : totalBits(size < 0 ? 0 : size) {
+        bits.resize(unitsFor(totalBits), 0ULL);
+    }
+
+    int size() const { return totalBits; }
+
+    int wordCount() const { return (int)bits.size(); }
+    unsigned long long* data() { return bits.data(); }
+    const unsigned long long* data() const { return bits.data(); }
+
+    void resize(int newSize) {
+        if (newSize < 0) newSize = 0;
+        totalBits = newSize;
+        bits.resize(unitsFor(newSize), 0ULL);
+        trimTail();
+    }
+
+    void reserve(int capacity) {
+        bits.reserve(unitsFor(capacity));
     }
 
+    // Setting a bit past the end grows the bitset instead of dropping it
     void set(int pos) {
-        if (pos < 0 || pos >= totalBits) return;
+        if (pos < 0) return;
+        if (pos >= totalBits) resize(pos + 1);
         int unit = pos / BITS_PER_UNIT;
         int offset = pos % BITS_PER_UNIT;
         bits[unit] |= (1ULL << offset);
@@ -153,6 +232,12 @@ public:
         bits[unit] &= ~(1ULL << offset);
     }
 
+    void flip(int pos) {
+        if (pos < 0) return;
+        if (pos >= totalBits) resize(pos + 1);
+        bits[pos / BITS_PER_UNIT] ^= (1ULL << (pos % BITS_PER_UNIT));
+    }
+
     bool test(int pos) const {
         if (pos < 0 || pos >= totalBits) return false;
         int unit = pos / BITS_PER_UNIT;
@@ -163,22 +248,155 @@ public:
     int count() const {
         int total = 0;
         for (unsigned long long unit : bits) {
-            unsigned long long temp = unit;
-            while (temp) {
-                total += temp & 1;
-                temp >>= 1;
-            }
+            total += popcount64(unit);
         }
         return total;
     }
 
+    bool any() const {
+        for (unsigned long long unit : bits) {
+            if (unit) return true;
+        }
+        return false;
+    }
+
+    bool none() const { return !any(); }
+
+    // First set bit at or after pos, or -1 if there is none
+    int findNext(int pos) const {
+        if (pos < 0) pos = 0;
+        if (pos >= totalBits) return -1;
+        int unit = pos / BITS_PER_UNIT;
+        unsigned long long word = bits[unit] & (~0ULL << (pos % BITS_PER_UNIT));
+        while (true) {
+            if (word) return unit * BITS_PER_UNIT + trailingZeros64(word);
+            if (++unit >= (int)bits.size()) return -1;
+            word = bits[unit];
+        }
+    }
+
+    int findFirst() const { return findNext(0); }
+
+    // Calls f(index) for every set bit in ascending order
+    template<typename Func>
+    void forEach(Func f) const {
+        for (int unit = 0; unit < (int)bits.size(); unit++) {
+            unsigned long long word = bits[unit];
+            while (word) {
+                f(unit * BITS_PER_UNIT + trailingZeros64(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    // Bulk operations run over the common prefix of words in a straight
+    // loop, which the compiler can vectorise. The result keeps this size.
     CustomBitset& operator|=(const CustomBitset& other) {
-        for (size_t i = 0; i < bits.size() && i < other.bits.size(); i++) {
-            bits[i] |= other.bits[i];
+        if (other.totalBits > totalBits) resize(other.totalBits);
+        const unsigned long long* src = other.bits.data();
+        unsigned long long* dst = bits.data();
+        size_t n = other.bits.size();
+        for (size_t i = 0; i < n; i++) {
+            dst[i] |= src[i];
+        }
+        return *this;
+    }
+
+    CustomBitset& operator&=(const CustomBitset& other) {
+        size_t common = min(bits.size(), other.bits.size());
+        const unsigned long long* src = other.bits.data();
+        unsigned long long* dst = bits.data();
+        for (size_t i = 0; i < common; i++) {
+            dst[i] &= src[i];
+        }
+        for (size_t i = common; i < bits.size(); i++) {
+            dst[i] = 0ULL;
+        }
+        return *this;
+    }
+
+    CustomBitset& operator^=(const CustomBitset& other) {
+        if (other.totalBits > totalBits) resize(other.totalBits);
+        const unsigned long long* src = other.bits.data();
+        unsigned long long* dst = bits.data();
+        size_t n = other.bits.size();
+        for (size_t i = 0; i < n; i++) {
+            dst[i] ^= src[i];
+        }
+        return *this;
+    }
+
+    // this = this AND NOT other
+    CustomBitset& andNot(const CustomBitset& other) {
+        size_t common = min(bits.size(), other.bits.size());
+        const unsigned long long* src = other.bits.data();
+        unsigned long long* dst = bits.data();
+        for (size_t i = 0; i < common; i++) {
+            dst[i] &= ~src[i];
         }
         return *this;
     }
 
+    CustomBitset operator|(const CustomBitset& other) const {
+        CustomBitset result = *this;
+        result |= other;
+        return result;
+    }
+
+    CustomBitset operator&(const CustomBitset& other) const {
+        CustomBitset result = *this;
+        result &= other;
+        return result;
+    }
+
+    CustomBitset operator^(const CustomBitset& other) const {
+        CustomBitset result = *this;
+        result ^= other;
+        return result;
+    }
+
+    bool operator==(const CustomBitset& other) const {
+        size_t common = min(bits.size(), other.bits.size());
+        for (size_t i = 0; i < common; i++) {
+            if (bits[i] != other.bits[i]) return false;
+        }
+        for (size_t i = common; i < bits.size(); i++) {
+            if (bits[i]) return false;
+        }
+        for (size_t i = common; i < other.bits.size(); i++) {
+            if (other.bits[i]) return false;
+        }
+        return true;
+    }
+
+    bool operator!=(const CustomBitset& other) const { return !(*this == other); }
+
+    // |this AND other| without building the intersection
+    int andCount(const CustomBitset& other) const {
+        size_t common = min(bits.size(), other.bits.size());
+        int total = 0;
+        for (size_t i = 0; i < common; i++) {
+            total += popcount64(bits[i] & other.bits[i]);
+        }
+        return total;
+    }
+
+    bool intersects(const CustomBitset& other) const {
+        size_t common = min(bits.size(), other.bits.size());
+        for (size_t i = 0; i < common; i++) {
+            if (bits[i] & other.bits[i]) return true;
+        }
+        return false;
+    }
+
+    bool isSubsetOf(const CustomBitset& other) const {
+        for (size_t i = 0; i < bits.size(); i++) {
+            unsigned long long theirs = i < other.bits.size() ? other.bits[i] : 0ULL;
+            if (bits[i] & ~theirs) return false;
+        }
+        return true;
+    }
+
     void clear() {
         for (auto& unit : bits) {
             unit = 0ULL;
@@ -258,14 +476,133 @@ public:
 
 class PeopleManager {
 public:
+    // Per-student course lists stored CSR-style: every row is a slice of one
+    // shared value array. A row that outgrows its slice is moved to the end
+    // with twice the room; compact() repacks rows in student order.
+    class CourseTable {
+    private:
+        vector<int> offset;
+        vector<int> length;
+        vector<int> capacity;
+        vector<int> values;
+        size_t unused;
+
+    public:
+        CourseTable() : unused(0) {}
+
+        void addRow() {
+            offset.push_back((int)values.size());
+            length.push_back(0);
+            capacity.push_back(0);
+        }
+
+        int rows() const { return offset.size(); }
+        int rowSize(int r) const { return length[r]; }
+        const int* rowBegin(int r) const { return values.data() + offset[r]; }
+        const int* rowEnd(int r) const { return values.data() + offset[r] + length[r]; }
+        int totalValues() const { return values.size() - unused; }
+
+        void append(int r, int value) {
+            if (length[r] == capacity[r]) {
+                if (unused > values.size() / 2 && values.size() > 4096) compact();
+                int newCapacity = max(4, capacity[r] * 2);
+                if ((size_t)(offset[r] + capacity[r]) == values.size()) {
+                    // Last slice in the array grows in place
+                    values.resize(offset[r] + newCapacity);
+                } else {
+                    int moved = values.size();
+                    values.resize(moved + newCapacity);
+                    copy(values.begin() + offset[r], values.begin() + offset[r] + length[r],
+                        values.begin() + moved);
+                    unused += capacity[r];
+                    offset[r] = moved;
+                }
+                unused += newCapacity - capacity[r];
+                capacity[r] = newCapacity;
+            }
+            values[offset[r] + length[r]++] = value;
+            unused--;
+        }
+
+        void clearRow(int r) {
+            unused += length[r];
+            length[r] = 0;
+        }
+
+        void compact() {
+            vector<int> packed;
+            packed.reserve(values.size() - unused);
+            for (size_t r = 0; r < offset.size(); r++) {
+                int start = packed.size();
+                packed.insert(packed.end(), values.begin() + offset[r], values.begin() + offset[r] + length[r]);
+                offset[r] = start;
+                capacity[r] = length[r];
+            }
+            values.swap(packed);
+            unused = 0;
+        }
+
+        size_t memoryBytes() const {
+            return (offset.capacity() + length.capacity() + capacity.capacity() + values.capacity()) * sizeof(int);
+        }
+    };
+
+    // View of one student's row in a CourseTable; reads like vector<int>
+    class CourseList {
+    private:
+        CourseTable* table;
+        int row;
+
+    public:
+        CourseList() : table(nullptr), row(0) {}
+        CourseList(CourseTable* t, int r) : table(t), row(r) {}
+
+        size_t size() const { return table->rowSize(row); }
+        bool empty() const { return size() == 0; }
+        const int* begin() const { return table->rowBegin(row); }
+        const int* end() const { return table->rowEnd(row); }
+        int operator[](size_t i) const { return begin()[i]; }
+        bool contains(int courseId) const { return find(begin(), end(), courseId) != end(); }
+        void push_back(int courseId) { table->append(row, courseId); }
+        void clear() { table->clearRow(row); }
+    };
+
     struct Student {
         int id;
-        string name;
-        vector<int> enrolled;
-        vector<int> completed;
+        string_view name;
+        CourseList enrolled;
+        CourseList completed;
+    };
 
-        Student() : id(-1) {}
-        Student(int i, string n) : id(i), name(n) {}
+    // Returned by getStudent: tests false for an unknown ID and gives
+    // pointer-style access to the student's fields. Views are invalidated
+    // by the next addStudent.
+    class StudentHandle {
+    private:
+        Student student;
+        bool valid;
+
+    public:
+        StudentHandle() : valid(false) {}
+        explicit StudentHandle(const Student& s) : student(s), valid(true) {}
+
+        explicit operator bool() const { return valid; }
+        Student* operator->() { return &student; }
+        const Student* operator->() const { return &student; }
+    };
+
+    // What a const PeopleManager (e.g. a published snapshot) hands out:
+    // the same views, reachable only through const Student*
+    class ConstStudentHandle {
+    private:
+        StudentHandle handle;
+
+    public:
+        ConstStudentHandle() {}
+        explicit ConstStudentHandle(const StudentHandle& h) : handle(h) {}
+
+        explicit operator bool() const { return (bool)handle; }
+        const Student* operator->() const { return handle.operator->(); }
     };
 
     struct Faculty {
@@ -287,14 +624,23 @@ public:
     };
 
 private:
-    vector<Student> students;
+    // Student columns: names share one arena, course lists are CSR tables
+    string nameArena;
+    vector<int> nameOffset;
+    vector<int> nameLength;
+    CourseTable enrolledTable;
+    CourseTable completedTable;
     vector<Faculty> faculties;
     vector<Room> rooms;
 
 public:
     int addStudent(const string& name) {
-        int id = students.size();
-        students.push_back(Student(id, name));
+        int id = nameOffset.size();
+        nameOffset.push_back(nameArena.size());
+        nameLength.push_back(name.size());
+        nameArena += name;
+        enrolledTable.addRow();
+        completedTable.addRow();
         return id;
     }
 
@@ -310,9 +656,47 @@ public:
         return id;
     }
 
-    Student* getStudent(int id) {
-        if (id < 0 || id >= (int)students.size()) return nullptr;
-        return &students[id];
+    StudentHandle getStudent(int id) {
+        if (id < 0 || id >= (int)nameOffset.size()) return StudentHandle();
+        Student s;
+        s.id = id;
+        s.name = getStudentName(id);
+        s.enrolled = CourseList(&enrolledTable, id);
+        s.completed = CourseList(&completedTable, id);
+        return StudentHandle(s);
+    }
+
+    ConstStudentHandle getStudent(int id) const {
+        return ConstStudentHandle(const_cast<PeopleManager*>(this)->getStudent(id));
+    }
+
+    string_view getStudentName(int id) const {
+        if (id < 0 || id >= (int)nameOffset.size()) return string_view();
+        return string_view(nameArena.data() + nameOffset[id], nameLength[id]);
+    }
+
+    // Names of students first..last-1 end to end: the arena holds them in
+    // ID order
+    string_view getStudentNames(int first, int last) const {
+        if (first < 0 || last > (int)nameOffset.size() || first >= last) return string_view();
+        return string_view(nameArena.data() + nameOffset[first],
+            nameOffset[last - 1] + nameLength[last - 1] - nameOffset[first]);
+    }
+
+    // Whole-table access for scans that visit every student in order
+    const CourseTable& enrollments() const { return enrolledTable; }
+    const CourseTable& completions() const { return completedTable; }
+
+    int getEnrollmentCount() const { return enrolledTable.totalValues(); }
+
+    void compact() {
+        enrolledTable.compact();
+        completedTable.compact();
+    }
+
+    size_t studentMemoryBytes() const {
+        return nameArena.capacity() + (nameOffset.capacity() + nameLength.capacity()) * sizeof(int)
+            + enrolledTable.memoryBytes() + completedTable.memoryBytes();
     }
 
     Faculty* getFaculty(int id) {
@@ -320,55 +704,113 @@ public:
         return &faculties[id];
     }
 
+    const Faculty* getFaculty(int id) const {
+        if (id < 0 || id >= (int)faculties.size()) return nullptr;
+        return &faculties[id];
+    }
+
     Room* getRoom(int id) {
         if (id < 0 || id >= (int)rooms.size()) return nullptr;
         return &rooms[id];
     }
 
-    int getStudentCount() const { return students.size(); }
+    const Room* getRoom(int id) const {
+        if (id < 0 || id >= (int)rooms.size()) return nullptr;
+        return &rooms[id];
+    }
+
+    int getStudentCount() const { return nameOffset.size(); }
     int getFacultyCount() const { return faculties.size(); }
     int getRoomCount() const { return rooms.size(); }
 };
 
 class OptimizedRelations {
 private:
-    static const int MAX_SIZE = 1000;
-    vector<CustomBitset> prereqBits;
+    // Row-major bit matrix in one contiguous allocation. Row i occupies
+    // words [i * stride, (i + 1) * stride). Capacity doubles on growth, so
+    // only the rows and words actually in use are touched by closure/copies.
+    vector<unsigned long long> matrix;
     int size;
+    int capacity;
+    int stride;
 
-public:
-    OptimizedRelations() : size(0) {
-        prereqBits.resize(MAX_SIZE, CustomBitset(MAX_SIZE));
+    static int wordsFor(int n) {
+        return (n + 63) / 64;
+    }
+
+    void grow(int minCapacity) {
+        int newCapacity = capacity == 0 ? 64 : capacity;
+        while (newCapacity < minCapacity) newCapacity *= 2;
+
+        int newStride = wordsFor(newCapacity);
+        vector<unsigned long long> grown((size_t)newCapacity * newStride, 0ULL);
+        for (int i = 0; i < size; i++) {
+            copy(matrix.begin() + (size_t)i * stride,
+                matrix.begin() + (size_t)i * stride + stride,
+                grown.begin() + (size_t)i * newStride);
+        }
+
+        matrix.swap(grown);
+        capacity = newCapacity;
+        stride = newStride;
     }
 
+public:
+    OptimizedRelations() : size(0), capacity(0), stride(0) {}
+
     void ensureSize(int n) {
+        if (n > capacity) {
+            grow(n);
+        }
         if (n > size) {
             size = n;
         }
     }
 
     void addPrereq(int a, int b) {
+        if (a < 0 || b < 0) return;
         ensureSize(max(a, b) + 1);
-        prereqBits[a].set(b);
+        matrix[(size_t)a * stride + b / 64] |= 1ULL << (b % 64);
     }
 
     bool getPrereq(int a, int b) const {
         if (a < 0 || b < 0 || a >= size || b >= size) return false;
-        return prereqBits[a].test(b);
+        return (matrix[(size_t)a * stride + b / 64] >> (b % 64)) & 1ULL;
     }
 
     int getSize() const { return size; }
 
+    int getCapacity() const { return capacity; }
+
     vector<CustomBitset> closurePrereq() const {
-        vector<CustomBitset> result = prereqBits;
+        // Work on a tightly packed copy of the live rows only
+        int words = wordsFor(size);
+        vector<unsigned long long> work((size_t)size * words);
+        for (int i = 0; i < size; i++) {
+            copy(matrix.begin() + (size_t)i * stride,
+                matrix.begin() + (size_t)i * stride + words,
+                work.begin() + (size_t)i * words);
+        }
 
         for (int k = 0; k < size; k++) {
+            const unsigned long long* rowK = work.data() + (size_t)k * words;
+            unsigned long long maskK = 1ULL << (k % 64);
             for (int i = 0; i < size; i++) {
-                if (result[i].test(k)) {
-                    result[i] |= result[k];
+                unsigned long long* rowI = work.data() + (size_t)i * words;
+                if (rowI[k / 64] & maskK) {
+                    for (int w = 0; w < words; w++) {
+                        rowI[w] |= rowK[w];
+                    }
                 }
             }
         }
+
+        vector<CustomBitset> result(size, CustomBitset(size));
+        for (int i = 0; i < size; i++) {
+            copy(work.begin() + (size_t)i * words,
+                work.begin() + (size_t)(i + 1) * words,
+                result[i].data());
+        }
         return result;
     }
 
@@ -381,40 +823,240 @@ public:
     }
 
     int countPrereqs(int course) const {
-        return prereqBits[course].count();
+        if (course < 0 || course >= size) return 0;
+        int total = 0;
+        for (int w = 0; w < stride; w++) {
+            total += CustomBitset::popcount64(matrix[(size_t)course * stride + w]);
+        }
+        return total;
     }
 
     vector<vector<bool>> toMatrix() const {
-        vector<vector<bool>> matrix(size, vector<bool>(size, false));
+        vector<vector<bool>> result(size, vector<bool>(size, false));
         for (int i = 0; i < size; i++) {
             for (int j = 0; j < size; j++) {
-                matrix[i][j] = prereqBits[i].test(j);
+                result[i][j] = getPrereq(i, j);
+            }
+        }
+        return result;
+    }
+};
+
+// Property checks on a bit-packed copy of a relation and its transpose.
+// Rows are compared a word at a time, and a failing check names a witness:
+// the element, pair or triple that breaks the property.
+class RelationProperties {
+public:
+    struct Witness {
+        bool holds;
+        int x, y, z;    // -1 where the property needs fewer elements
+
+        Witness() : holds(true), x(-1), y(-1), z(-1) {}
+        Witness(int a, int b = -1, int c = -1) : holds(false), x(a), y(b), z(c) {}
+
+        explicit operator bool() const { return holds; }
+    };
+
+private:
+    int n;
+    int stride;
+    vector<unsigned long long> rows;       // row i: words [i * stride, (i + 1) * stride)
+    vector<unsigned long long> columns;    // transpose, same layout
+    vector<int> firstWord;                 // non-zero word span of each row
+    vector<int> endWord;
+    vector<int> rowClass;                  // identical rows share an ID
+    int classCount;
+
+    const unsigned long long* row(int i) const { return rows.data() + (size_t)i * stride; }
+    const unsigned long long* column(int i) const { return columns.data() + (size_t)i * stride; }
+
+    static bool test(const unsigned long long* r, int j) {
+        return (r[j / 64] >> (j % 64)) & 1ULL;
+    }
+
+    void classifyRows() {
+        vector<pair<unsigned long long, int>> keyed(n);
+        for (int i = 0; i < n; i++) {
+            unsigned long long h = 14695981039346656037ULL;
+            for (int w = firstWord[i]; w < endWord[i]; w++) {
+                h = (h ^ row(i)[w]) * 1099511628211ULL;
+            }
+            keyed[i] = make_pair(h ^ (unsigned long long)firstWord[i], i);
+        }
+        sort(keyed.begin(), keyed.end());
+
+        rowClass.assign(n, -1);
+        classCount = 0;
+        for (int a = 0; a < n; a++) {
+            int i = keyed[a].second;
+            // Equal hashes are grouped; confirm against earlier rows of the run
+            for (int b = a - 1; b >= 0 && keyed[b].first == keyed[a].first; b--) {
+                int j = keyed[b].second;
+                if (equal(row(i), row(i) + stride, row(j))) {
+                    rowClass[i] = rowClass[j];
+                    break;
+                }
+            }
+            if (rowClass[i] < 0) rowClass[i] = classCount++;
+        }
+    }
+
+public:
+    explicit RelationProperties(const vector<vector<bool>>& matrix)
+        : n(matrix.size()), stride((n + 63) / 64), classCount(0) {
+        rows.assign((size_t)n * stride, 0ULL);
+        columns.assign((size_t)n * stride, 0ULL);
+        firstWord.assign(n, 0);
+        endWord.assign(n, 0);
+
+        for (int i = 0; i < n; i++) {
+            unsigned long long* r = rows.data() + (size_t)i * stride;
+            int width = min((int)matrix[i].size(), n);
+            for (int j = 0; j < width; j++) {
+                if (matrix[i][j]) r[j / 64] |= 1ULL << (j % 64);
+            }
+        }
+
+        for (int i = 0; i < n; i++) {
+            const unsigned long long* r = row(i);
+            int first = stride, last = 0;
+            for (int w = 0; w < stride; w++) {
+                unsigned long long bits = r[w];
+                if (bits == 0) continue;
+                if (first == stride) first = w;
+                last = w + 1;
+                while (bits) {
+                    int j = w * 64 + CustomBitset::trailingZeros64(bits);
+                    columns[(size_t)j * stride + i / 64] |= 1ULL << (i % 64);
+                    bits &= bits - 1;
+                }
+            }
+            firstWord[i] = first == stride ? 0 : first;
+            endWord[i] = last;
+        }
+
+        classifyRows();
+    }
+
+    int size() const { return n; }
+
+    // Witness x: (x, x) is missing
+    Witness reflexive() const {
+        for (int i = 0; i < n; i++) {
+            if (!test(row(i), i)) return Witness(i);
+        }
+        return Witness();
+    }
+
+    // Witness (x, y): in R while (y, x) is not
+    Witness symmetric() const {
+        for (int i = 0; i < n; i++) {
+            const unsigned long long* r = row(i);
+            const unsigned long long* c = column(i);
+            for (int w = 0; w < stride; w++) {
+                unsigned long long diff = r[w] ^ c[w];
+                if (diff == 0) continue;
+                int j = w * 64 + CustomBitset::trailingZeros64(diff);
+                return test(r, j) ? Witness(i, j) : Witness(j, i);
             }
         }
-        return matrix;
+        return Witness();
+    }
+
+    // Witness (x, y): x != y with both (x, y) and (y, x) in R
+    Witness antiSymmetric() const {
+        for (int i = 0; i < n; i++) {
+            const unsigned long long* r = row(i);
+            const unsigned long long* c = column(i);
+            for (int w = firstWord[i]; w < endWord[i]; w++) {
+                unsigned long long both = r[w] & c[w];
+                if (w == i / 64) both &= ~(1ULL << (i % 64));
+                if (both) return Witness(i, w * 64 + CustomBitset::trailingZeros64(both));
+            }
+        }
+        return Witness();
+    }
+
+    // R is transitive when, for every x, the rows of all y related to x
+    // fall inside row x. Each distinct row is tested once per x, so the
+    // blocks of an equivalence relation cost O(n) words per row.
+    // Witness (x, y, z): (x, y) and (y, z) in R but (x, z) is not.
+    Witness transitive() const {
+        vector<int> checkedFor(classCount, -1);
+
+        for (int i = 0; i < n; i++) {
+            const unsigned long long* ri = row(i);
+            checkedFor[rowClass[i]] = i;
+
+            for (int w = firstWord[i]; w < endWord[i]; w++) {
+                unsigned long long bits = ri[w];
+                while (bits) {
+                    int j = w * 64 + CustomBitset::trailingZeros64(bits);
+                    bits &= bits - 1;
+                    if (checkedFor[rowClass[j]] == i) continue;
+                    checkedFor[rowClass[j]] = i;
+
+                    const unsigned long long* rj = row(j);
+                    for (int v = firstWord[j]; v < endWord[j]; v++) {
+                        unsigned long long extra = rj[v] & ~ri[v];
+                        if (extra) return Witness(i, j, v * 64 + CustomBitset::trailingZeros64(extra));
+                    }
+                }
+            }
+        }
+        return Witness();
+    }
+
+    bool isEquivalence() const {
+        return reflexive() && symmetric() && transitive();
+    }
+
+    bool isPartialOrder() const {
+        return reflexive() && antiSymmetric() && transitive();
     }
 };
 
 class Relations {
 private:
     vector<vector<bool>> prereq;
+    vector<vector<int>> directPrereqs;
     int size;
 
 public:
+    // Why a course is not yet open to a student. frontier holds the missing
+    // prerequisites that can be taken now; every other missing course waits
+    // on one of them. path is a shortest chain from a frontier course to
+    // the target.
+    struct MissingPrereqs {
+        bool eligible;
+        vector<int> missing;
+        vector<int> frontier;
+        vector<int> path;
+    };
+
     Relations() : size(0) {}
 
     void ensureSize(int n) {
         if (n > size) {
+            for (auto& row : prereq) row.resize(n, false);
             prereq.resize(n, vector<bool>(n, false));
+            directPrereqs.resize(n);
             size = n;
         }
     }
 
     void addPrereq(int a, int b) {
         ensureSize(max(a, b) + 1);
+        if (!prereq[a][b]) directPrereqs[b].push_back(a);
         prereq[a][b] = true;
     }
 
+    const vector<int>& prerequisitesOf(int courseId) const {
+        static const vector<int> none;
+        if (courseId < 0 || courseId >= size) return none;
+        return directPrereqs[courseId];
+    }
+
     bool getPrereq(int a, int b) const {
         if (a < 0 || b < 0 || a >= size || b >= size) return false;
         return prereq[a][b];
@@ -427,8 +1069,9 @@ public:
 
         for (int k = 0; k < size; k++) {
             for (int i = 0; i < size; i++) {
+                if (!result[i][k]) continue;
                 for (int j = 0; j < size; j++) {
-                    if (result[i][k] && result[k][j]) {
+                    if (result[k][j]) {
                         result[i][j] = true;
                     }
                 }
@@ -437,6 +1080,70 @@ public:
         return result;
     }
 
+    // Column of the transitive closure for one course: every course with a
+    // prerequisite path into target. Walks the paths backwards over the
+    // prerequisite lists in O(V+E) instead of building the whole closure.
+    vector<bool> ancestorsOf(int target) const {
+        vector<bool> reached(size, false);
+        if (target < 0 || target >= size) return reached;
+
+        vector<int> frontier(1, target);
+        while (!frontier.empty()) {
+            int x = frontier.back();
+            frontier.pop_back();
+            for (int i : directPrereqs[x]) {
+                if (!reached[i]) {
+                    reached[i] = true;
+                    frontier.push_back(i);
+                }
+            }
+        }
+        return reached;
+    }
+
+    // Breadth-first backwards from the target through unsatisfied courses
+    // only, since a completed course's own prerequisites no longer matter.
+    // Every course and edge is visited at most once, and BFS order makes the
+    // first frontier course found the nearest one.
+    MissingPrereqs explainMissing(int target, const vector<bool>& completed) const {
+        MissingPrereqs result;
+        result.eligible = true;
+        if (target < 0 || target >= size) return result;
+        auto done = [&](int c) { return c < (int)completed.size() && completed[c]; };
+
+        // -2 unseen, -1 the target, otherwise the course one step closer to it
+        vector<int> next(size, -2);
+        vector<int> queue(1, target);
+        next[target] = -1;
+        int nearest = -1;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int x = queue[head];
+            bool open = true;
+            for (int p : directPrereqs[x]) {
+                if (done(p)) continue;
+                open = false;
+                if (next[p] == -2) {
+                    next[p] = x;
+                    queue.push_back(p);
+                }
+            }
+            if (x == target) {
+                result.eligible = open;
+                continue;
+            }
+            result.missing.push_back(x);
+            if (open) {
+                result.frontier.push_back(x);
+                if (nearest < 0) nearest = x;
+            }
+        }
+
+        for (int c = nearest; c >= 0; c = next[c]) result.path.push_back(c);
+        sort(result.missing.begin(), result.missing.end());
+        sort(result.frontier.begin(), result.frontier.end());
+        return result;
+    }
+
     bool hasPrereqCycle() const {
         auto closure = closurePrereq();
         for (int i = 0; i < size; i++) {
@@ -454,45 +1161,30 @@ public:
         return true;
     }
 
+    // Packs the matrix once; use this to test several properties or to
+    // get witnesses for the ones that fail
+    RelationProperties properties() const {
+        return RelationProperties(prereq);
+    }
+
     bool isSymmetric() const {
-        for (int i = 0; i < size; i++) {
-            for (int j = 0; j < size; j++) {
-                if (prereq[i][j] != prereq[j][i]) return false;
-            }
-        }
-        return true;
+        return (bool)properties().symmetric();
     }
 
     bool isTransitive() const {
-        for (int i = 0; i < size; i++) {
-            for (int j = 0; j < size; j++) {
-                for (int k = 0; k < size; k++) {
-                    if (prereq[i][j] && prereq[j][k] && !prereq[i][k]) {
-                        return false;
-                    }
-                }
-            }
-        }
-        return true;
+        return (bool)properties().transitive();
     }
 
     bool isAntiSymmetric() const {
-        for (int i = 0; i < size; i++) {
-            for (int j = 0; j < size; j++) {
-                if (i != j && prereq[i][j] && prereq[j][i]) {
-                    return false;
-                }
-            }
-        }
-        return true;
+        return (bool)properties().antiSymmetric();
     }
 
     bool isEquivalenceRelation() const {
-        return isReflexive() && isSymmetric() && isTransitive();
+        return properties().isEquivalence();
     }
 
     bool isPartialOrder() const {
-        return isReflexive() && isTransitive() && isAntiSymmetric();
+        return properties().isPartialOrder();
     }
 };
 
@@ -600,14 +1292,14 @@ public:
         return true;
     }
 
-    static void analyzeStudentCourses(PeopleManager& pm, const CourseManager& cm) {
+    static void analyzeStudentCourses(const PeopleManager& pm, const CourseManager& cm) {
         DisplayHelper::printHeader("STUDENT -> COURSES MAPPING ANALYSIS");
 
         cout << "\nMulti-valued Function: Student -> Set of Courses\n";
         cout << "Domain size: " << pm.getStudentCount() << " students\n\n";
 
         for (int i = 0; i < pm.getStudentCount(); i++) {
-            auto* student = pm.getStudent(i);
+            auto student = pm.getStudent(i);
             if (student) {
                 cout << "  " << student->name << " -> {";
                 for (size_t j = 0; j < student->enrolled.size(); j++) {
@@ -622,7 +1314,7 @@ public:
     }
 
     static void analyzeFacultyRooms(const CustomMap<int, int>& facultyToRoom,
-        PeopleManager& pm) {
+        const PeopleManager& pm) {
         DisplayHelper::printHeader("FACULTY -> ROOMS MAPPING");
 
         cout << "\nAnalyzing Faculty -> Room assignment\n";
@@ -675,7 +1367,7 @@ public:
     }
 
     static void display(const CustomMap<int, int>& courseToFaculty,
-        const CourseManager& cm, PeopleManager& pm) {
+        const CourseManager& cm, const PeopleManager& pm) {
         DisplayHelper::printHeader("FUNCTION PROPERTIES (MODULE 7)");
 
         cout << "\nAnalyzing Course -> Faculty mapping\n";
@@ -702,412 +1394,512 @@ public:
     }
 };
 
+// Proofs are trees of typed nodes: a rule ID, the parent node and up to
+// three entity IDs (courses, sets, counts). Nodes are kept in preorder, so a
+// parent always precedes its children. Text is produced only when a writer
+// renders the tree, and verdict-only callers build no nodes at all.
 class ProofGenerator {
-private:
-    const Relations& relations;
-    const CourseManager& cm;
+public:
+    enum ProofRule : unsigned short {
+        PR_THEOREM_ENROLL, PR_BASE_CASE, PR_DIRECT_DONE, PR_DIRECT_MISSING, PR_NO_DIRECT,
+        PR_INDUCTIVE_STEP, PR_INDIRECT_DONE, PR_INDIRECT_MISSING, PR_PREREQ_PASS, PR_PREREQ_FAIL,
+        PR_THEOREM_CHAIN, PR_CONSTRUCTION, PR_FIRST_SEMESTER, PR_CAN_TAKE, PR_CHAIN_PASS,
+        PR_THEOREM_ACYCLIC, PR_ASSUME_CYCLE, PR_CYCLE_FORM, PR_CYCLE_FOUND, PR_ACYCLIC_FAIL,
+        PR_NO_CYCLE, PR_ACYCLIC_PASS,
+        PR_THEOREM_EQUIVALENCE, PR_REFLEXIVE, PR_NOT_REFLEXIVE, PR_SYMMETRIC, PR_NOT_SYMMETRIC,
+        PR_TRANSITIVE, PR_NOT_TRANSITIVE, PR_EQUIVALENCE_PASS, PR_EQUIVALENCE_FAIL,
+        PR_THEOREM_PARTITION, PR_OVERLAP, PR_DISJOINT, PR_PARTITION_PASS, PR_PARTITION_FAIL,
+        PR_THEOREM_PIGEONHOLE, PR_PIGEONHOLE_GIVEN, PR_PIGEONHOLE_BOUND, PR_PIGEONHOLE_PASS,
+        PR_PIGEONHOLE_ROOM,
+        PR_TAKE_NEXT_HEADER, PR_TAKE_NEXT, PR_MISSING_CYCLE, PR_MISSING_COVERED,
+        PR_PATH_HEADER, PR_PATH_STEP, PR_PATH_TARGET,
+        PR_RULE_COUNT
+    };
 
-    struct ProofStep {
-        string statement;
-        string justification;
-        int level;
+    struct ProofNode {
+        unsigned short rule;
+        unsigned short level;
+        int parent;
+        int a, b, c;
     };
 
-    vector<ProofStep> proofSteps;
+private:
+    // %0 %1 %2 are the node's entities, %C the course code of entity 0 and
+    // %S the student name of entity 0
+    struct RuleText {
+        const char* statement;
+        const char* justification;
+    };
 
-public:
-    ProofGenerator(const Relations& r, const CourseManager& c)
-        : relations(r), cm(c) {
+    static const RuleText& ruleText(int rule) {
+        static const RuleText table[PR_RULE_COUNT] = {
+            { "THEOREM: Student can enroll in %C", "To be proven using mathematical induction" },
+            { "BASE CASE: Check direct prerequisites", "Definition of prerequisite relation" },
+            { "%C is completed [PASS]", "Given in completed courses set" },
+            { "%C is NOT completed [FAIL]", "Missing from completed set" },
+            { "No direct prerequisites required", "Empty prerequisite set" },
+            { "INDUCTIVE STEP: Check transitive closure", "Strong induction on prerequisite chain" },
+            { "Indirect prerequisite %C satisfied [PASS]", "By transitive closure of prerequisite relation" },
+            { "Indirect prerequisite %C NOT satisfied [FAIL]", "Required by transitivity" },
+            { "CONCLUSION: Prerequisites satisfied [PASS] Q.E.D.", "By mathematical induction, all prerequisites met" },
+            { "CONCLUSION: Prerequisites NOT satisfied [FAIL]", "Proof fails - missing required courses" },
+            { "THEOREM: %S can complete degree requirements", "Proof by construction - building valid course sequence" },
+            { "CONSTRUCTION: Order courses by prerequisite chains", "Using topological sort on prerequisite DAG" },
+            { "SEMESTER 1: Courses with no prerequisites (%0 courses)", "These form the base of our construction" },
+            { "  Can take: %C", "No prerequisites required" },
+            { "CONCLUSION: Valid course sequence exists [PASS] Q.E.D.", "By construction, all prerequisites can be satisfied" },
+            { "THEOREM: Prerequisite graph is acyclic (DAG)", "Proof by contradiction" },
+            { "ASSUMPTION: Suppose a cycle exists", "For sake of contradiction" },
+            { "Let courses C1 -> C2 -> ... -> Cn -> C1 form a cycle", "Where -> denotes prerequisite relation" },
+            { "CONTRADICTION FOUND: Cycle detected in system", "Student cannot complete C1 (requires completing C1 first)" },
+            { "CONCLUSION: Prerequisite graph contains cycles [FAIL]", "System needs correction - remove circular dependencies" },
+            { "No cycle found in transitive closure", "Checked all reachability paths" },
+            { "CONCLUSION: Prerequisite graph is acyclic [PASS] Q.E.D.", "No contradictions found - graph is a valid DAG" },
+            { "THEOREM: Relation R is an equivalence relation", "Must prove reflexive, symmetric, and transitive" },
+            { "REFLEXIVE: For all x, (x,x) in R [PASS]", "Verified for all elements" },
+            { "NOT REFLEXIVE [FAIL]", "Element %0 is not related to itself" },
+            { "SYMMETRIC: For all x,y, (x,y) in R implies (y,x) in R [PASS]", "Verified for all pairs" },
+            { "NOT SYMMETRIC [FAIL]", "(%0,%1) in R but (%1,%0) is not" },
+            { "TRANSITIVE: For all x,y,z, (x,y) and (y,z) implies (x,z) [PASS]", "Verified for all triples" },
+            { "NOT TRANSITIVE [FAIL]", "(%0,%1) and (%1,%2) in R but (%0,%2) is not" },
+            { "CONCLUSION: R is an equivalence relation [PASS] Q.E.D.", "All three properties satisfied" },
+            { "CONCLUSION: R is NOT an equivalence relation [FAIL]", "One or more properties failed" },
+            { "THEOREM: Collection forms a valid partition", "Must prove: disjoint, non-empty, union = whole set" },
+            { "Sets %0 and %1 overlap [FAIL]", "Both contain %2" },
+            { "All sets are pairwise disjoint [PASS]", "No common elements found" },
+            { "CONCLUSION: Valid partition [PASS] Q.E.D.", "All partition properties satisfied" },
+            { "CONCLUSION: NOT a valid partition [FAIL]", "Disjointness property violated" },
+            { "THEOREM: Pigeonhole Principle Application", "If n items in m containers and n > m, some container has >1 item" },
+            { "Given: %0 students, %1 time slots", "Pigeons=%0, Holes=%1" },
+            { "At least one time slot must have >=%0 students", "By Pigeonhole Principle: ceiling(n/m)" },
+            { "CONCLUSION: Schedule conflict guaranteed [PASS] Q.E.D.", "Cannot avoid overlap with current resources" },
+            { "Sufficient time slots available", "No guaranteed conflict" },
+            { "TAKE NEXT: %0 of %1 missing courses are open now", "Every other missing course requires one of these" },
+            { "%C can be taken now", "All of its prerequisites are completed" },
+            { "TAKE NEXT: none - the missing courses form a prerequisite cycle", "No missing course has all of its prerequisites completed" },
+            { "Missing courses lie only behind completed courses", "The completed courses that require them are already done" },
+            { "SHORTEST REMAINING PATH: %0 courses", "From the nearest open course to the target" },
+            { "Step %1: %C", "Unlocks the next step" },
+            { "Step %1: %C", "Target course" }
+        };
+        return table[rule];
     }
 
-    void generatePrereqProof(int courseId, const vector<bool>& completed) {
-        proofSteps.clear();
+    const Relations& relations;
+    const CourseManager& cm;
+    const PeopleManager* people;
 
-        const auto* course = cm.getCourse(courseId);
-        string courseName = course ? course->code : to_string(courseId);
+    vector<ProofNode> nodes;
+    bool proved;
 
-        proofSteps.push_back({
-            "THEOREM: Student can enroll in " + courseName,
-            "To be proven using mathematical induction",
-            0
-            });
+    // Prerequisites of each course, transitively, computed on first use.
+    // The relation must not change while the generator is in use.
+    mutable vector<vector<int>> requiredCache;
+    mutable vector<bool> requiredKnown;
 
-        proofSteps.push_back({
-            "BASE CASE: Check direct prerequisites",
-            "Definition of prerequisite relation",
-            1
-            });
+    void add(ProofRule rule, int level, int a = 0, int b = 0, int c = 0) {
+        int parent = (int)nodes.size() - 1;
+        while (parent >= 0 && nodes[parent].level >= level) parent = nodes[parent].parent;
+        nodes.push_back({ (unsigned short)rule, (unsigned short)level, parent, a, b, c });
+    }
 
-        auto prereq = relations.getPrereqMatrix();
-        bool hasDirectPrereq = false;
+    void start() {
+        nodes.clear();
+        proved = false;
+    }
 
-        for (int i = 0; i < (int)prereq.size(); i++) {
-            if (prereq[i][courseId]) {
-                hasDirectPrereq = true;
-                const auto* p = cm.getCourse(i);
-                string pName = p ? p->code : to_string(i);
-
-                if (completed[i]) {
-                    proofSteps.push_back({
-                        pName + " is completed [PASS]",
-                        "Given in completed courses set",
-                        2
-                        });
-                }
-                else {
-                    proofSteps.push_back({
-                        pName + " is NOT completed [FAIL]",
-                        "Missing from completed set",
-                        2
-                        });
-                }
+    static bool isDone(const vector<bool>& completed, int course) {
+        return course >= 0 && course < (int)completed.size() && completed[course];
+    }
+
+    const vector<int>& requiredFor(int courseId) const {
+        if ((int)requiredKnown.size() < relations.getSize()) {
+            requiredKnown.resize(relations.getSize(), false);
+            requiredCache.resize(relations.getSize());
+        }
+        static const vector<int> none;
+        if (courseId < 0 || courseId >= (int)requiredKnown.size()) return none;
+        if (!requiredKnown[courseId]) {
+            vector<bool> reached = relations.ancestorsOf(courseId);
+            vector<int>& list = requiredCache[courseId];
+            for (int i = 0; i < (int)reached.size(); i++) {
+                if (reached[i]) list.push_back(i);
             }
+            requiredKnown[courseId] = true;
         }
+        return requiredCache[courseId];
+    }
 
-        if (!hasDirectPrereq) {
-            proofSteps.push_back({
-                "No direct prerequisites required",
-                "Empty prerequisite set",
-                2
-                });
-        }
+    enum Escape { ESC_NONE, ESC_QUOTED };
 
-        proofSteps.push_back({
-            "INDUCTIVE STEP: Check transitive closure",
-            "Strong induction on prerequisite chain",
-            1
-            });
+    static void put(ostream& out, string_view text, Escape esc) {
+        if (esc == ESC_NONE) {
+            out << text;
+            return;
+        }
+        for (char ch : text) {
+            if (ch == '"' || ch == '\\') out << '\\' << ch;
+            else if (ch == '\n') out << "\\n";
+            else if ((unsigned char)ch < 0x20) out << ' ';
+            else out << ch;
+        }
+    }
 
-        auto closure = relations.closurePrereq();
-        for (int i = 0; i < (int)closure.size(); i++) {
-            if (closure[i][courseId] && i != courseId) {
-                const auto* p = cm.getCourse(i);
-                string pName = p ? p->code : to_string(i);
-
-                if (completed[i]) {
-                    proofSteps.push_back({
-                        "Indirect prerequisite " + pName + " satisfied [PASS]",
-                        "By transitive closure of prerequisite relation",
-                        2
-                        });
-                }
-                else {
-                    proofSteps.push_back({
-                        "Indirect prerequisite " + pName + " NOT satisfied [FAIL]",
-                        "Required by transitivity",
-                        2
-                        });
-                }
+    void expand(ostream& out, const char* tpl, const ProofNode& n, Escape esc) const {
+        const char* run = tpl;
+        for (const char* p = tpl; *p; p++) {
+            if (*p != '%' || !p[1]) continue;
+            put(out, string_view(run, p - run), esc);
+            switch (*++p) {
+            case '0': out << n.a; break;
+            case '1': out << n.b; break;
+            case '2': out << n.c; break;
+            case 'C': {
+                const auto* course = cm.getCourse(n.a);
+                if (course) put(out, course->code, esc);
+                else out << n.a;
+                break;
+            }
+            case 'S': {
+                auto student = people ? people->getStudent(n.a) : PeopleManager::ConstStudentHandle();
+                if (student) put(out, student->name, esc);
+                else out << n.a;
+                break;
             }
+            default: out << '%' << *p; break;
+            }
+            run = p + 1;
         }
+        put(out, string_view(run), esc);
+    }
 
-        bool allSatisfied = true;
-        for (int i = 0; i < (int)closure.size(); i++) {
-            if (closure[i][courseId] && !completed[i]) {
-                allSatisfied = false;
-                break;
+    // Replaces the flat list of every missing closure member with what the
+    // student can take next and the shortest way to the target
+    void explainFailure(int courseId, const vector<bool>& completed) {
+        auto why = relations.explainMissing(courseId, completed);
+        if (why.eligible) {
+            add(PR_MISSING_COVERED, 1);
+            return;
+        }
+        if (why.frontier.empty()) add(PR_MISSING_CYCLE, 1);
+        else {
+            add(PR_TAKE_NEXT_HEADER, 1, (int)why.frontier.size(), (int)why.missing.size());
+            for (int c : why.frontier) add(PR_TAKE_NEXT, 2, c);
+        }
+        if (!why.path.empty()) {
+            add(PR_PATH_HEADER, 1, (int)why.path.size());
+            for (int i = 0; i < (int)why.path.size(); i++) {
+                add(i + 1 == (int)why.path.size() ? PR_PATH_TARGET : PR_PATH_STEP, 2, why.path[i], i + 1);
             }
         }
+    }
 
-        proofSteps.push_back({
-            allSatisfied ? "CONCLUSION: Prerequisites satisfied [PASS] Q.E.D."
-                        : "CONCLUSION: Prerequisites NOT satisfied [FAIL]",
-            allSatisfied ? "By mathematical induction, all prerequisites met"
-                        : "Proof fails - missing required courses",
-            0
-            });
+public:
+    ProofGenerator(const Relations& r, const CourseManager& c)
+        : relations(r), cm(c), people(nullptr), proved(false) {
     }
 
-    void generateCourseChainProof(int studentId, PeopleManager& pm) {
-        proofSteps.clear();
+    // Verdict only: no nodes, and each course's prerequisite list is found
+    // once per generator
+    bool prereqVerdict(int courseId, const vector<bool>& completed) const {
+        for (int i : requiredFor(courseId)) {
+            if (!isDone(completed, i)) return false;
+        }
+        return true;
+    }
 
-        auto* student = pm.getStudent(studentId);
-        string studentName = student ? student->name : to_string(studentId);
+    // Checks every enrollment against the student's completed courses;
+    // returns the failing (student, course) pairs
+    vector<pair<int, int>> auditEnrollments(const PeopleManager& pm) const {
+        vector<pair<int, int>> unmet;
+        vector<bool> completed(max(relations.getSize(), cm.count()), false);
+        for (int s = 0; s < pm.getStudentCount(); s++) {
+            auto student = pm.getStudent(s);
+            if (!student) continue;
+            for (int c : student->completed) {
+                if (c >= 0 && c < (int)completed.size()) completed[c] = true;
+            }
+            for (int c : student->enrolled) {
+                if (!prereqVerdict(c, completed)) unmet.push_back(make_pair(s, c));
+            }
+            for (int c : student->completed) {
+                if (c >= 0 && c < (int)completed.size()) completed[c] = false;
+            }
+        }
+        return unmet;
+    }
 
-        proofSteps.push_back({
-            "THEOREM: " + studentName + " can complete degree requirements",
-            "Proof by construction - building valid course sequence",
-            0
-            });
+    void generatePrereqProof(int courseId, const vector<bool>& completed) {
+        start();
+        add(PR_THEOREM_ENROLL, 0, courseId);
+        add(PR_BASE_CASE, 1);
 
-        proofSteps.push_back({
-            "CONSTRUCTION: Order courses by prerequisite chains",
-            "Using topological sort on prerequisite DAG",
-            1
-            });
+        bool hasDirectPrereq = false;
+        for (int i = 0; i < relations.getSize(); i++) {
+            if (relations.getPrereq(i, courseId)) {
+                hasDirectPrereq = true;
+                add(isDone(completed, i) ? PR_DIRECT_DONE : PR_DIRECT_MISSING, 2, i);
+            }
+        }
+        if (!hasDirectPrereq) add(PR_NO_DIRECT, 2);
 
-        if (student) {
-            vector<int> noPrerequCourses;
-            auto matrix = relations.getPrereqMatrix();
+        add(PR_INDUCTIVE_STEP, 1);
+        bool allSatisfied = true;
+        for (int i : requiredFor(courseId)) {
+            if (!isDone(completed, i)) allSatisfied = false;
+            if (i != courseId) add(isDone(completed, i) ? PR_INDIRECT_DONE : PR_INDIRECT_MISSING, 2, i);
+        }
+
+        proved = allSatisfied;
+        if (!allSatisfied) explainFailure(courseId, completed);
+        add(allSatisfied ? PR_PREREQ_PASS : PR_PREREQ_FAIL, 0);
+    }
+
+    void generateCourseChainProof(int studentId, const PeopleManager& pm) {
+        start();
+        people = &pm;
+        add(PR_THEOREM_CHAIN, 0, studentId);
+        add(PR_CONSTRUCTION, 1);
 
+        auto student = pm.getStudent(studentId);
+        if (student) {
+            vector<int> noPrereqCourses;
             for (int c : student->enrolled) {
                 bool hasPrereq = false;
                 for (int i = 0; i < relations.getSize(); i++) {
-                    if (matrix[i][c]) {
+                    if (relations.getPrereq(i, c)) {
                         hasPrereq = true;
                         break;
                     }
                 }
-                if (!hasPrereq) {
-                    noPrerequCourses.push_back(c);
-                }
+                if (!hasPrereq) noPrereqCourses.push_back(c);
             }
 
-            proofSteps.push_back({
-                "SEMESTER 1: Courses with no prerequisites (" +
-                to_string(noPrerequCourses.size()) + " courses)",
-                "These form the base of our construction",
-                2
-                });
-
-            for (int c : noPrerequCourses) {
-                const auto* course = cm.getCourse(c);
-                proofSteps.push_back({
-                    "  Can take: " + (course ? course->code : to_string(c)),
-                    "No prerequisites required",
-                    3
-                    });
-            }
+            add(PR_FIRST_SEMESTER, 2, (int)noPrereqCourses.size());
+            for (int c : noPrereqCourses) add(PR_CAN_TAKE, 3, c);
         }
 
-        proofSteps.push_back({
-            "CONCLUSION: Valid course sequence exists [PASS] Q.E.D.",
-            "By construction, all prerequisites can be satisfied",
-            0
-            });
+        proved = true;
+        add(PR_CHAIN_PASS, 0);
     }
 
     void generateAcyclicProof() {
-        proofSteps.clear();
-
-        proofSteps.push_back({
-            "THEOREM: Prerequisite graph is acyclic (DAG)",
-            "Proof by contradiction",
-            0
-            });
-
-        proofSteps.push_back({
-            "ASSUMPTION: Suppose a cycle exists",
-            "For sake of contradiction",
-            1
-            });
-
-        proofSteps.push_back({
-            "Let courses C1 -> C2 -> ... -> Cn -> C1 form a cycle",
-            "Where -> denotes prerequisite relation",
-            2
-            });
-
-        bool hasCycle = relations.hasPrereqCycle();
-
-        if (hasCycle) {
-            proofSteps.push_back({
-                "CONTRADICTION FOUND: Cycle detected in system",
-                "Student cannot complete C1 (requires completing C1 first)",
-                2
-                });
-
-            proofSteps.push_back({
-                "CONCLUSION: Prerequisite graph contains cycles [FAIL]",
-                "System needs correction - remove circular dependencies",
-                0
-                });
+        start();
+        add(PR_THEOREM_ACYCLIC, 0);
+        add(PR_ASSUME_CYCLE, 1);
+        add(PR_CYCLE_FORM, 2);
+
+        if (relations.hasPrereqCycle()) {
+            add(PR_CYCLE_FOUND, 2);
+            add(PR_ACYCLIC_FAIL, 0);
         }
         else {
-            proofSteps.push_back({
-                "No cycle found in transitive closure",
-                "Checked all reachability paths",
-                2
-                });
-
-            proofSteps.push_back({
-                "CONCLUSION: Prerequisite graph is acyclic [PASS] Q.E.D.",
-                "No contradictions found - graph is a valid DAG",
-                0
-                });
+            proved = true;
+            add(PR_NO_CYCLE, 2);
+            add(PR_ACYCLIC_PASS, 0);
         }
     }
 
     void generateEquivalenceProof(const vector<vector<bool>>& relation) {
-        proofSteps.clear();
+        start();
+        add(PR_THEOREM_EQUIVALENCE, 0);
 
-        proofSteps.push_back({
-            "THEOREM: Relation R is an equivalence relation",
-            "Must prove reflexive, symmetric, and transitive",
-            0
-            });
+        RelationProperties props(relation);
 
-        bool reflexive = true;
-        for (int i = 0; i < (int)relation.size(); i++) {
-            if (!relation[i][i]) {
-                reflexive = false;
-                break;
-            }
-        }
+        auto reflexive = props.reflexive();
+        if (reflexive) add(PR_REFLEXIVE, 1);
+        else add(PR_NOT_REFLEXIVE, 1, reflexive.x);
 
-        proofSteps.push_back({
-            reflexive ? "REFLEXIVE: For all x, (x,x) in R [PASS]" : "NOT REFLEXIVE [FAIL]",
-            reflexive ? "Verified for all elements" : "Found element not related to itself",
-            1
-            });
+        auto symmetric = props.symmetric();
+        if (symmetric) add(PR_SYMMETRIC, 1);
+        else add(PR_NOT_SYMMETRIC, 1, symmetric.x, symmetric.y);
 
-        bool symmetric = true;
-        for (int i = 0; i < (int)relation.size(); i++) {
-            for (int j = 0; j < (int)relation.size(); j++) {
-                if (relation[i][j] != relation[j][i]) {
-                    symmetric = false;
-                    break;
-                }
+        auto transitive = props.transitive();
+        if (transitive) add(PR_TRANSITIVE, 1);
+        else add(PR_NOT_TRANSITIVE, 1, transitive.x, transitive.y, transitive.z);
+
+        proved = reflexive && symmetric && transitive;
+        add(proved ? PR_EQUIVALENCE_PASS : PR_EQUIVALENCE_FAIL, 0);
+    }
+
+    void generatePartitionProof(const vector<CustomSet<int>>& partition) {
+        start();
+        add(PR_THEOREM_PARTITION, 0);
+
+        // One pass over all elements: holders[e] chains every set seen so far
+        // that holds e, and each new holder is paired with all of them, so
+        // overlaps are found without intersecting every pair of sets.
+        // Element IDs spread far wider than their count fall back to sorting
+        // (element, set) pairs and pairing within each run.
+        struct Overlap {
+            int first, second, element;
+            bool operator<(const Overlap& o) const {
+                return first != o.first ? first < o.first : second != o.second ? second < o.second : element < o.element;
+            }
+        };
+        vector<Overlap> overlaps;
+
+        long long lo = LLONG_MAX, hi = LLONG_MIN, total = 0;
+        for (const auto& block : partition) {
+            for (int e : block.getVector()) {
+                lo = min(lo, (long long)e);
+                hi = max(hi, (long long)e);
+                total++;
             }
-            if (!symmetric) break;
         }
 
-        proofSteps.push_back({
-            symmetric ? "SYMMETRIC: For all x,y, (x,y) in R implies (y,x) in R [PASS]" : "NOT SYMMETRIC [FAIL]",
-            symmetric ? "Verified for all pairs" : "Found asymmetric pair",
-            1
-            });
-
-        bool transitive = true;
-        for (int i = 0; i < (int)relation.size(); i++) {
-            for (int j = 0; j < (int)relation.size(); j++) {
-                for (int k = 0; k < (int)relation.size(); k++) {
-                    if (relation[i][j] && relation[j][k] && !relation[i][k]) {
-                        transitive = false;
-                        break;
-                    }
+        if (total > 0 && hi - lo < 4 * total + 1024) {
+            vector<int> holders(hi - lo + 1, -1);
+            vector<pair<int, int>> chain;     // (set, previous holder link)
+            chain.reserve(total);
+            for (int i = 0; i < (int)partition.size(); i++) {
+                for (int e : partition[i].getVector()) {
+                    int& head = holders[e - lo];
+                    for (int h = head; h >= 0; h = chain[h].second) overlaps.push_back({ chain[h].first, i, e });
+                    chain.push_back(make_pair(i, head));
+                    head = (int)chain.size() - 1;
                 }
             }
         }
+        else if (total > 0) {
+            vector<pair<int, int>> held;
+            held.reserve(total);
+            for (int i = 0; i < (int)partition.size(); i++) {
+                for (int e : partition[i].getVector()) held.push_back(make_pair(e, i));
+            }
+            sort(held.begin(), held.end());
+            for (size_t a = 1, run = 0; a < held.size(); a++) {
+                if (held[a].first != held[run].first) run = a;
+                for (size_t b = run; b < a; b++) overlaps.push_back({ held[b].second, held[a].second, held[a].first });
+            }
+        }
 
-        proofSteps.push_back({
-            transitive ? "TRANSITIVE: For all x,y,z, (x,y) and (y,z) implies (x,z) [PASS]" : "NOT TRANSITIVE [FAIL]",
-            transitive ? "Verified for all triples" : "Found violation of transitivity",
-            1
-            });
+        // Report each overlapping pair once, with its smallest shared element
+        sort(overlaps.begin(), overlaps.end());
+        bool disjoint = overlaps.empty();
+        for (size_t a = 0; a < overlaps.size(); a++) {
+            if (a > 0 && overlaps[a].first == overlaps[a - 1].first && overlaps[a].second == overlaps[a - 1].second) continue;
+            add(PR_OVERLAP, 2, overlaps[a].first, overlaps[a].second, overlaps[a].element);
+        }
+        if (disjoint) add(PR_DISJOINT, 1);
 
-        bool isEquiv = reflexive && symmetric && transitive;
-        proofSteps.push_back({
-            isEquiv ? "CONCLUSION: R is an equivalence relation [PASS] Q.E.D."
-                   : "CONCLUSION: R is NOT an equivalence relation [FAIL]",
-            isEquiv ? "All three properties satisfied" : "One or more properties failed",
-            0
-            });
+        proved = disjoint;
+        add(disjoint ? PR_PARTITION_PASS : PR_PARTITION_FAIL, 0);
     }
 
-    void generatePartitionProof(const vector<CustomSet<int>>& partition) {
-        proofSteps.clear();
-
-        proofSteps.push_back({
-            "THEOREM: Collection forms a valid partition",
-            "Must prove: disjoint, non-empty, union = whole set",
-            0
-            });
+    void generatePigeonholeProof(int pigeons, int holes) {
+        start();
+        add(PR_THEOREM_PIGEONHOLE, 0);
+        add(PR_PIGEONHOLE_GIVEN, 1, pigeons, holes);
 
-        bool disjoint = true;
-        for (size_t i = 0; i < partition.size(); i++) {
-            for (size_t j = i + 1; j < partition.size(); j++) {
-                auto intersect = partition[i].intersection(partition[j]);
-                if (!intersect.empty()) {
-                    disjoint = false;
-                    proofSteps.push_back({
-                        "Sets " + to_string(i) + " and " + to_string(j) +
-                        " overlap [FAIL]",
-                        "Found common elements",
-                        2
-                        });
-                }
-            }
+        if (pigeons > holes) {
+            proved = true;
+            add(PR_PIGEONHOLE_BOUND, 2, pigeons / holes + 1);
+            add(PR_PIGEONHOLE_PASS, 0);
         }
-
-        if (disjoint) {
-            proofSteps.push_back({
-                "All sets are pairwise disjoint [PASS]",
-                "No common elements found",
-                1
-                });
+        else {
+            add(PR_PIGEONHOLE_ROOM, 2);
         }
-
-        proofSteps.push_back({
-            disjoint ? "CONCLUSION: Valid partition [PASS] Q.E.D."
-                     : "CONCLUSION: NOT a valid partition [FAIL]",
-            disjoint ? "All partition properties satisfied"
-                     : "Disjointness property violated",
-            0
-            });
     }
 
-    void generatePigeonholeProof(int pigeons, int holes) {
-        proofSteps.clear();
+    // The verdict of the last generated proof
+    bool holds() const { return proved; }
+    int stepCount() const { return (int)nodes.size(); }
+    const ProofNode& step(int i) const { return nodes[i]; }
 
-        proofSteps.push_back({
-            "THEOREM: Pigeonhole Principle Application",
-            "If n items in m containers and n > m, some container has >1 item",
-            0
-            });
+    string statement(int i) const {
+        stringstream out;
+        expand(out, ruleText(nodes[i].rule).statement, nodes[i], ESC_NONE);
+        return out.str();
+    }
 
-        proofSteps.push_back({
-            "Given: " + to_string(pigeons) + " students, " +
-            to_string(holes) + " time slots",
-            "Pigeons=" + to_string(pigeons) + ", Holes=" + to_string(holes),
-            1
-            });
+    string justification(int i) const {
+        stringstream out;
+        expand(out, ruleText(nodes[i].rule).justification, nodes[i], ESC_NONE);
+        return out.str();
+    }
 
-        if (pigeons > holes) {
-            int minPerSlot = (pigeons / holes) + 1;
-            proofSteps.push_back({
-                "At least one time slot must have >=" + to_string(minPerSlot) +
-                " students",
-                "By Pigeonhole Principle: ceiling(n/m)",
-                2
-                });
+    void writeText(ostream& out, bool withJustification = true) const {
+        for (const auto& n : nodes) {
+            string indent(n.level * 2, ' ');
+            out << indent;
+            expand(out, ruleText(n.rule).statement, n, ESC_NONE);
+            out << "\n";
+            if (withJustification) {
+                out << indent << "  -> ";
+                expand(out, ruleText(n.rule).justification, n, ESC_NONE);
+                out << "\n\n";
+            }
+        }
+    }
 
-            proofSteps.push_back({
-                "CONCLUSION: Schedule conflict guaranteed [PASS] Q.E.D.",
-                "Cannot avoid overlap with current resources",
-                0
-                });
+    // {"holds":..,"steps":[{"rule":..,"statement":..,"justification":..,"children":[..]}]}
+    void writeJson(ostream& out) const {
+        out << "{\"holds\":" << (proved ? "true" : "false") << ",\"steps\":[";
+        vector<int> open;
+        bool comma = false;
+        for (int i = 0; i < (int)nodes.size(); i++) {
+            const ProofNode& n = nodes[i];
+            while (!open.empty() && open.back() != n.parent) {
+                out << "]}";
+                open.pop_back();
+                comma = true;
+            }
+            if (comma) out << ",";
+            out << "{\"rule\":" << n.rule << ",\"statement\":\"";
+            expand(out, ruleText(n.rule).statement, n, ESC_QUOTED);
+            out << "\",\"justification\":\"";
+            expand(out, ruleText(n.rule).justification, n, ESC_QUOTED);
+            out << "\",\"children\":[";
+            open.push_back(i);
+            comma = false;
         }
-        else {
-            proofSteps.push_back({
-                "Sufficient time slots available",
-                "No guaranteed conflict",
-                2
-                });
+        for (size_t i = 0; i < open.size(); i++) out << "]}";
+        out << "]}\n";
+    }
+
+    void writeDot(ostream& out) const {
+        out << "digraph proof {\n  node [shape=box];\n";
+        for (int i = 0; i < (int)nodes.size(); i++) {
+            const ProofNode& n = nodes[i];
+            out << "  n" << i << " [label=\"";
+            expand(out, ruleText(n.rule).statement, n, ESC_QUOTED);
+            out << "\\n";
+            expand(out, ruleText(n.rule).justification, n, ESC_QUOTED);
+            out << "\"];\n";
+            if (n.parent >= 0) out << "  n" << n.parent << " -> n" << i << ";\n";
         }
+        out << "}\n";
     }
 
     void display() const {
         DisplayHelper::printHeader("FORMAL PROOF (MODULE 8)");
-
-        for (const auto& step : proofSteps) {
-            string indent(step.level * 2, ' ');
-            cout << indent << step.statement << "\n";
-            cout << indent << "  -> " << step.justification << "\n\n";
-        }
+        writeText(cout);
     }
 };
 
 class ConsistencyChecker {
 private:
     const CourseManager& cm;
-    PeopleManager& pm;
+    const PeopleManager& pm;
     const Relations& rel;
-    CustomMap<int, int>& courseToFaculty;
-    CustomMap<int, int>& courseToRoom;
+    const CustomMap<int, int>& courseToFaculty;
+    const CustomMap<int, int>& courseToRoom;
 
     vector<string> errors;
     vector<string> warnings;
+    vector<string> notes;
 
 public:
-    ConsistencyChecker(const CourseManager& c, PeopleManager& p,
-        const Relations& r, CustomMap<int, int>& cf, CustomMap<int, int>& cr)
+    ConsistencyChecker(const CourseManager& c, const PeopleManager& p,
+        const Relations& r, const CustomMap<int, int>& cf, const CustomMap<int, int>& cr)
         : cm(c), pm(p), rel(r), courseToFaculty(cf), courseToRoom(cr) {
     }
 
     void runAllChecks() {
         errors.clear();
         warnings.clear();
+        notes.clear();
 
         checkPrereqCycles();
         checkStudentPrereqs();
@@ -1128,7 +1920,7 @@ public:
         auto closure = rel.closurePrereq();
 
         for (int s = 0; s < pm.getStudentCount(); s++) {
-            auto* student = pm.getStudent(s);
+            auto student = pm.getStudent(s);
             if (!student) continue;
 
             CustomSet<int> enrolled;
@@ -1152,11 +1944,11 @@ public:
     }
 
     void checkStudentOverload() {
-        for (int s = 0; s < pm.getStudentCount(); s++) {
-            auto* student = pm.getStudent(s);
-            if (student && student->enrolled.size() > 6) {
+        const auto& enrolled = pm.enrollments();
+        for (int s = 0; s < enrolled.rows(); s++) {
+            if (enrolled.rowSize(s) > 6) {
                 stringstream ss;
-                ss << student->name << " enrolled in " << student->enrolled.size()
+                ss << pm.getStudentName(s) << " enrolled in " << enrolled.rowSize(s)
                     << " courses (overload)";
                 warnings.push_back(ss.str());
             }
@@ -1196,7 +1988,7 @@ public:
 
             int enrolled = 0;
             for (int s = 0; s < pm.getStudentCount(); s++) {
-                auto* student = pm.getStudent(s);
+                auto student = pm.getStudent(s);
                 if (student) {
                     if (find(student->enrolled.begin(), student->enrolled.end(), pair.first)
                         != student->enrolled.end()) {
@@ -1233,26 +2025,39 @@ public:
         }
     }
 
+    // One student bitset per course, built in a single pass over enrollments
+    vector<CustomBitset> buildCourseRosters() const {
+        vector<CustomBitset> rosters(cm.count(), CustomBitset(pm.getStudentCount()));
+        const auto& enrolled = pm.enrollments();
+        for (int s = 0; s < enrolled.rows(); s++) {
+            for (const int* c = enrolled.rowBegin(s); c != enrolled.rowEnd(s); ++c) {
+                if (*c >= 0 && *c < cm.count()) {
+                    rosters[*c].set(s);
+                }
+            }
+        }
+        return rosters;
+    }
+
+    // Shared enrollments are informational: they land in notes, not on cout,
+    // so callers such as the request server control all output
     void checkCourseOverlaps() {
-        DisplayHelper::printInfo("Checking course overlaps using set intersections...");
+        vector<CustomBitset> rosters = buildCourseRosters();
 
         for (int c1 = 0; c1 < cm.count(); c1++) {
             for (int c2 = c1 + 1; c2 < cm.count(); c2++) {
-                CustomSet<int> students1 = getCourseStudents(c1);
-                CustomSet<int> students2 = getCourseStudents(c2);
+                int common = rosters[c1].andCount(rosters[c2]);
 
-                CustomSet<int> intersection = students1.intersection(students2);
-
-                if (intersection.size() > 0) {
+                if (common > 0) {
                     const auto* course1 = cm.getCourse(c1);
                     const auto* course2 = cm.getCourse(c2);
 
                     stringstream ss;
-                    ss << intersection.size() << " students enrolled in both "
+                    ss << common << " students enrolled in both "
                         << (course1 ? course1->code : to_string(c1)) << " and "
                         << (course2 ? course2->code : to_string(c2));
 
-                    DisplayHelper::printInfo(ss.str());
+                    notes.push_back(ss.str());
                 }
             }
         }
@@ -1261,18 +2066,14 @@ public:
     void checkScheduleConflicts() {
         DisplayHelper::printInfo("Checking schedule conflicts using graph coloring...");
 
-        vector<CustomSet<int>> conflictGraph(cm.count());
+        vector<CustomBitset> rosters = buildCourseRosters();
+        vector<CustomBitset> conflictGraph(cm.count(), CustomBitset(cm.count()));
 
         for (int c1 = 0; c1 < cm.count(); c1++) {
             for (int c2 = c1 + 1; c2 < cm.count(); c2++) {
-                CustomSet<int> students1 = getCourseStudents(c1);
-                CustomSet<int> students2 = getCourseStudents(c2);
-
-                CustomSet<int> common = students1.intersection(students2);
-
-                if (common.size() > 0) {
-                    conflictGraph[c1].insert(c2);
-                    conflictGraph[c2].insert(c1);
+                if (rosters[c1].intersects(rosters[c2])) {
+                    conflictGraph[c1].set(c2);
+                    conflictGraph[c2].set(c1);
                 }
             }
         }
@@ -1281,16 +2082,16 @@ public:
         int maxColor = 0;
 
         for (int c = 0; c < cm.count(); c++) {
-            CustomSet<int> usedColors;
+            CustomBitset usedColors(cm.count() + 1);
 
-            for (const auto& neighbor : conflictGraph[c].getVector()) {
+            conflictGraph[c].forEach([&](int neighbor) {
                 if (colors[neighbor] != -1) {
-                    usedColors.insert(colors[neighbor]);
+                    usedColors.set(colors[neighbor]);
                 }
-            }
+            });
 
             int color = 0;
-            while (usedColors.contains(color)) color++;
+            while (usedColors.test(color)) color++;
 
             colors[c] = color;
             maxColor = max(maxColor, color);
@@ -1305,7 +2106,7 @@ public:
     CustomSet<int> getCourseStudents(int courseId) const {
         CustomSet<int> students;
         for (int s = 0; s < pm.getStudentCount(); s++) {
-            auto* student = pm.getStudent(s);
+            auto student = pm.getStudent(s);
             if (student) {
                 if (find(student->enrolled.begin(), student->enrolled.end(), courseId)
                     != student->enrolled.end()) {
@@ -1316,6 +2117,10 @@ public:
         return students;
     }
 
+    const vector<string>& getErrors() const { return errors; }
+    const vector<string>& getWarnings() const { return warnings; }
+    const vector<string>& getNotes() const { return notes; }
+
     void displayReport() const {
         DisplayHelper::printHeader("CONSISTENCY REPORT (MODULE 9)");
 
@@ -1497,219 +2302,1495 @@ public:
         benchmarkFunctionChecks(500);
         benchmarkFunctionChecks(1000);
 
-        CourseManager cm;
-        PeopleManager pm2;
-        Relations rel5;
-        benchmarkConsistencyChecks(cm, pm2, rel5, 20);
+        CourseManager cm;
+        PeopleManager pm2;
+        Relations rel5;
+        benchmarkConsistencyChecks(cm, pm2, rel5, 20);
+
+        displayResults();
+        cache.displayStats();
+    }
+
+    void displayResults() const {
+        DisplayHelper::printHeader("BENCHMARK RESULTS");
+
+        cout << "\n" << left << setw(40) << "Operation"
+            << setw(12) << "Time (ms)"
+            << setw(10) << "Size"
+            << "Complexity\n";
+        cout << string(75, '-') << "\n";
+
+        for (const auto& r : results) {
+            cout << left << setw(40) << r.operation
+                << setw(12) << r.milliseconds
+                << setw(10) << r.dataSize
+                << r.complexity << "\n";
+        }
+
+        cout << "\nNote: ms = milliseconds, w = word size (typically 64 bits)\n";
+    }
+};
+
+// Everything the menus edit, bundled so a whole version can be copied and
+// published at once
+struct UniversityModel {
+    CourseManager cm;
+    PeopleManager pm;
+    Relations rel;
+    CustomMap<int, int> courseToFaculty;
+    CustomMap<int, int> courseToRoom;
+    CustomMap<int, int> facultyToRoom;
+    unsigned long long version = 0;
+};
+
+// Read-copy-update home of the model. Readers grab the current version with
+// snapshot() and no lock; a report keeps its snapshot alive for as long as it
+// runs, so it never sees a half-applied edit and never holds up writers.
+// Writers are serialized: update() copies the latest version, edits the copy
+// and swaps it in atomically. Superseded versions are freed when their last
+// reader drops them. Each write copies the model, so batch bulk edits into
+// one update().
+class ModelStore {
+public:
+    typedef shared_ptr<const UniversityModel> Snapshot;
+
+private:
+    Snapshot current;
+    mutex writeLock;
+
+public:
+    ModelStore() : current(make_shared<const UniversityModel>()) {}
+
+    ModelStore(const ModelStore&) = delete;
+    ModelStore& operator=(const ModelStore&) = delete;
+
+    Snapshot snapshot() const {
+        return atomic_load(&current);
+    }
+
+    unsigned long long version() const {
+        return snapshot()->version;
+    }
+
+    // edit(UniversityModel&) returns false to reject the change, in which
+    // case nothing is published
+    template<typename Edit>
+    bool update(Edit edit) {
+        lock_guard<mutex> lock(writeLock);
+        auto next = make_shared<UniversityModel>(*atomic_load(&current));
+        if (!edit(*next)) return false;
+        next->version++;
+        atomic_store(&current, Snapshot(std::move(next)));
+        return true;
+    }
+};
+
+// Background writer for exports. The producer fills chunks and hands them
+// to one thread that writes them out, so formatting the next chunk
+// overlaps writing the last. Written chunks come back for reuse, and at
+// most MAX_QUEUED wait at a time. borrow() queues a span of caller-owned
+// memory as is; it must stay valid until close().
+class ChunkWriter {
+private:
+    static const size_t MAX_QUEUED = 4;
+
+    struct Piece {
+        string owned;
+        const char* data;
+        size_t size;
+    };
+
+    ostream& out;
+    size_t chunkBytes;
+    string current;
+    deque<Piece> queue;
+    vector<string> spare;
+    mutex lock;
+    condition_variable ready;
+    condition_variable drained;
+    bool closing;
+    bool failed;
+    unsigned long long written;
+    thread worker;
+
+    void run() {
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            ready.wait(guard, [this] { return !queue.empty() || closing; });
+            if (queue.empty()) break;
+            Piece piece = std::move(queue.front());
+            queue.pop_front();
+            drained.notify_one();
+            guard.unlock();
+
+            size_t size = piece.data ? piece.size : piece.owned.size();
+            if (!failed) out.write(piece.data ? piece.data : piece.owned.data(), size);
+            bool ok = (bool)out;
+
+            guard.lock();
+            written += size;
+            if (!ok) failed = true;
+            if (!piece.data) {
+                piece.owned.clear();
+                spare.push_back(std::move(piece.owned));
+            }
+        }
+    }
+
+    void enqueue(Piece&& piece) {
+        unique_lock<mutex> guard(lock);
+        drained.wait(guard, [this] { return queue.size() < MAX_QUEUED; });
+        queue.push_back(std::move(piece));
+        ready.notify_one();
+    }
+
+    void handOff() {
+        if (current.empty()) return;
+        Piece piece;
+        piece.owned.swap(current);
+        piece.data = nullptr;
+        piece.size = 0;
+        enqueue(std::move(piece));
+        lock_guard<mutex> guard(lock);
+        if (!spare.empty()) {
+            current.swap(spare.back());
+            spare.pop_back();
+        }
+        else {
+            current.reserve(chunkBytes + 64);
+        }
+    }
+
+public:
+    explicit ChunkWriter(ostream& o, size_t chunk = 1 << 20)
+        : out(o), chunkBytes(max(chunk, (size_t)64)), closing(false), failed(false), written(0) {
+        current.reserve(chunkBytes + 64);
+        worker = thread(&ChunkWriter::run, this);
+    }
+
+    ~ChunkWriter() { close(); }
+
+    ChunkWriter(const ChunkWriter&) = delete;
+    ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+    void append(const char* data, size_t size) {
+        current.append(data, size);
+        if (current.size() >= chunkBytes) handOff();
+    }
+
+    void append(string_view s) { append(s.data(), s.size()); }
+
+    void put(char c) {
+        current.push_back(c);
+        if (current.size() >= chunkBytes) handOff();
+    }
+
+    void zeros(size_t count) {
+        current.append(count, '\0');
+        if (current.size() >= chunkBytes) handOff();
+    }
+
+    void number(long long value) {
+        char digits[24];
+        append(digits, to_chars(digits, digits + sizeof(digits), value).ptr - digits);
+    }
+
+    // Little-endian on every platform this builds for
+    void int32(int value) { append(reinterpret_cast<const char*>(&value), 4); }
+
+    // Spans much smaller than a chunk are cheaper to copy than to queue
+    void borrow(const char* data, size_t size) {
+        if (size < chunkBytes / 4) {
+            append(data, size);
+            return;
+        }
+        handOff();
+        Piece piece;
+        piece.data = data;
+        piece.size = size;
+        enqueue(std::move(piece));
+    }
+
+    // Writes everything still queued and stops the thread; false if any
+    // write failed
+    bool close() {
+        if (worker.joinable()) {
+            handOff();
+            {
+                lock_guard<mutex> guard(lock);
+                closing = true;
+            }
+            ready.notify_one();
+            worker.join();
+            out.flush();
+            if (!out) failed = true;
+        }
+        return !failed;
+    }
+
+    unsigned long long bytesWritten() const { return written; }
+};
+
+// Minimal FlatBuffers builder for Arrow IPC metadata. Like the reference
+// builder it fills its buffer back to front, so every object is complete
+// before anything that points at it. A Ref is an object's distance from
+// the end of the buffer. Tables do not nest: build strings, vectors and
+// child tables first.
+class FlatBuilder {
+public:
+    typedef size_t Ref;
+
+private:
+    vector<unsigned char> buf;
+    size_t head;
+    size_t minAlign;
+    size_t tableStart;
+    vector<pair<int, size_t>> fields;
+
+    size_t used() const { return buf.size() - head; }
+
+    void reserve(size_t n) {
+        while (head < n) {
+            vector<unsigned char> bigger(buf.size() * 2);
+            memcpy(bigger.data() + bigger.size() - used(), buf.data() + head, used());
+            head += bigger.size() - buf.size();
+            buf.swap(bigger);
+        }
+    }
+
+    void pad(size_t n) {
+        reserve(n);
+        head -= n;
+        memset(buf.data() + head, 0, n);
+    }
+
+    // Pads so an object of `size` bytes written after `extra` more bytes
+    // is aligned
+    void align(size_t size, size_t extra) {
+        minAlign = max(minAlign, size);
+        pad((~(used() + extra) + 1) & (size - 1));
+    }
+
+    template<typename T>
+    void push(T value) {
+        align(sizeof(T), 0);
+        reserve(sizeof(T));
+        head -= sizeof(T);
+        memcpy(buf.data() + head, &value, sizeof(T));
+    }
+
+    void pushRef(Ref target) {
+        align(4, 0);
+        push<unsigned int>((unsigned int)(used() + 4 - target));
+    }
+
+public:
+    FlatBuilder() : buf(1024), head(1024), minAlign(1), tableStart(0) {}
+
+    Ref text(string_view s) {
+        align(4, s.size() + 1);
+        pad(1);
+        reserve(s.size());
+        head -= s.size();
+        memcpy(buf.data() + head, s.data(), s.size());
+        push<unsigned int>((unsigned int)s.size());
+        return used();
+    }
+
+    Ref refVector(const vector<Ref>& items) {
+        align(4, items.size() * 4);
+        for (size_t i = items.size(); i-- > 0;) pushRef(items[i]);
+        push<unsigned int>((unsigned int)items.size());
+        return used();
+    }
+
+    // Vector of {int64, int64} structs: Arrow's FieldNode and Buffer
+    Ref pairVector(const vector<pair<long long, long long>>& items) {
+        align(4, items.size() * 16);
+        align(8, items.size() * 16);
+        for (size_t i = items.size(); i-- > 0;) {
+            push<long long>(items[i].second);
+            push<long long>(items[i].first);
+        }
+        push<unsigned int>((unsigned int)items.size());
+        return used();
+    }
+
+    void startTable() {
+        fields.clear();
+        tableStart = used();
+    }
+
+    template<typename T>
+    void addScalar(int slot, T value) {
+        push<T>(value);
+        fields.push_back({ slot, used() });
+    }
+
+    void addRef(int slot, Ref target) {
+        pushRef(target);
+        fields.push_back({ slot, used() });
+    }
+
+    Ref endTable() {
+        push<int>(0);
+        size_t table = used();
+        int slots = 0;
+        for (const auto& f : fields) slots = max(slots, f.first + 1);
+        vector<unsigned short> vtable(slots + 2, 0);
+        vtable[0] = (unsigned short)(vtable.size() * 2);
+        vtable[1] = (unsigned short)(table - tableStart);
+        for (const auto& f : fields) vtable[2 + f.first] = (unsigned short)(table - f.second);
+        for (size_t i = vtable.size(); i-- > 0;) push<unsigned short>(vtable[i]);
+        int toVtable = (int)(used() - table);
+        memcpy(buf.data() + buf.size() - table, &toVtable, 4);
+        return table;
+    }
+
+    // Root offset in front, total padded to a multiple of 8
+    string finish(Ref root) {
+        align(max(minAlign, (size_t)8), 4);
+        pushRef(root);
+        return string(reinterpret_cast<const char*>(buf.data() + head), used());
+    }
+};
+
+// Streams every table of one snapshot as CSV, JSON Lines or an Arrow IPC
+// stream (the .arrows streaming format, readable by pyarrow.ipc.open_stream
+// and other Arrow readers). Cells are read straight out of the model and
+// formatted into the writer's chunks, and contiguous student names are
+// handed to the writer without copying. Arrow output is cut into record
+// batches of at most batchRows rows. The snapshot stays alive for as long
+// as the exporter does, so exports run alongside edits.
+class DataExporter {
+public:
+    enum Format { FORMAT_CSV, FORMAT_JSONL, FORMAT_ARROW };
+
+    struct Column {
+        enum Kind { INT, TEXT, INT_LIST };
+        string name;
+        Kind kind;
+        function<int(int)> number;
+        function<string_view(int)> text;
+        function<pair<const int*, const int*>(int)> list;
+        // Optional: texts of rows first..last-1 laid end to end in memory
+        function<string_view(int, int)> textRun;
+    };
+
+    struct Table {
+        string name;
+        int rows;
+        vector<Column> columns;
+    };
+
+    struct Stats {
+        bool ok;
+        int rows;
+        int batches;                 // Arrow record batches
+        unsigned long long bytes;
+    };
+
+private:
+    enum MessageType { MESSAGE_SCHEMA = 1, MESSAGE_RECORD_BATCH = 3 };
+    enum ArrowType { ARROW_INT = 2, ARROW_UTF8 = 5, ARROW_LIST = 12 };
+    static const short METADATA_V5 = 4;
+
+    ModelStore::Snapshot model;
+    int batchRows;
+    size_t chunkBytes;
+    vector<pair<int, int>> prereqPairs;
+    vector<Table> tables;
+
+    static Column intColumn(const string& name, function<int(int)> f) {
+        Column c;
+        c.name = name;
+        c.kind = Column::INT;
+        c.number = std::move(f);
+        return c;
+    }
+
+    static Column textColumn(const string& name, function<string_view(int)> f) {
+        Column c;
+        c.name = name;
+        c.kind = Column::TEXT;
+        c.text = std::move(f);
+        return c;
+    }
+
+    static Column listColumn(const string& name, function<pair<const int*, const int*>(int)> f) {
+        Column c;
+        c.name = name;
+        c.kind = Column::INT_LIST;
+        c.list = std::move(f);
+        return c;
+    }
+
+    static Table mapTable(const string& name, const string& keyName, const string& valueName,
+        const CustomMap<int, int>& map) {
+        const CustomMap<int, int>* m = &map;
+        return { name, map.size(), {
+            intColumn(keyName, [m](int r) { return (m->begin() + r)->first; }),
+            intColumn(valueName, [m](int r) { return (m->begin() + r)->second; }) } };
+    }
+
+    void buildTables() {
+        const UniversityModel& m = *model;
+
+        tables.push_back({ "courses", m.cm.count(), {
+            intColumn("id", [&m](int r) { return m.cm.getCourse(r)->id; }),
+            textColumn("code", [&m](int r) { return string_view(m.cm.getCourse(r)->code); }),
+            textColumn("name", [&m](int r) { return string_view(m.cm.getCourse(r)->name); }),
+            intColumn("credits", [&m](int r) { return m.cm.getCourse(r)->credits; }) } });
+
+        Column studentName = textColumn("name", [&m](int r) { return m.pm.getStudentName(r); });
+        studentName.textRun = [&m](int first, int last) { return m.pm.getStudentNames(first, last); };
+        tables.push_back({ "students", m.pm.getStudentCount(), {
+            intColumn("id", [](int r) { return r; }),
+            studentName,
+            listColumn("enrolled", [&m](int r) {
+                return make_pair(m.pm.enrollments().rowBegin(r), m.pm.enrollments().rowEnd(r)); }),
+            listColumn("completed", [&m](int r) {
+                return make_pair(m.pm.completions().rowBegin(r), m.pm.completions().rowEnd(r)); }) } });
+
+        tables.push_back({ "faculty", m.pm.getFacultyCount(), {
+            intColumn("id", [&m](int r) { return m.pm.getFaculty(r)->id; }),
+            textColumn("name", [&m](int r) { return string_view(m.pm.getFaculty(r)->name); }),
+            listColumn("courses", [&m](int r) {
+                const auto& c = m.pm.getFaculty(r)->courses;
+                return make_pair(c.data(), c.data() + c.size()); }) } });
+
+        tables.push_back({ "rooms", m.pm.getRoomCount(), {
+            intColumn("id", [&m](int r) { return m.pm.getRoom(r)->id; }),
+            textColumn("name", [&m](int r) { return string_view(m.pm.getRoom(r)->name); }),
+            intColumn("capacity", [&m](int r) { return m.pm.getRoom(r)->capacity; }) } });
+
+        // The relation is kept as a matrix plus per-course lists; the edge
+        // table needs a row index, so the pairs are listed once here
+        for (int course = 0; course < m.rel.getSize(); course++) {
+            for (int prereq : m.rel.prerequisitesOf(course)) prereqPairs.push_back({ prereq, course });
+        }
+        const vector<pair<int, int>>* pairs = &prereqPairs;
+        tables.push_back({ "prerequisites", (int)prereqPairs.size(), {
+            intColumn("prerequisite", [pairs](int r) { return (*pairs)[r].first; }),
+            intColumn("course", [pairs](int r) { return (*pairs)[r].second; }) } });
+
+        tables.push_back(mapTable("course_faculty", "course", "faculty", m.courseToFaculty));
+        tables.push_back(mapTable("course_room", "course", "room", m.courseToRoom));
+        tables.push_back(mapTable("faculty_room", "faculty", "room", m.facultyToRoom));
+    }
+
+    static long long padded(long long bytes) { return (bytes + 7) & ~7LL; }
+
+    static void csvText(ChunkWriter& w, string_view s) {
+        if (s.find_first_of(",\"\r\n") == string_view::npos) {
+            w.append(s);
+            return;
+        }
+        w.put('"');
+        size_t from = 0;
+        for (size_t q = s.find('"'); q != string_view::npos; q = s.find('"', q + 1)) {
+            w.append(s.substr(from, q + 1 - from));
+            w.put('"');
+            from = q + 1;
+        }
+        w.append(s.substr(from));
+        w.put('"');
+    }
+
+    static void jsonText(ChunkWriter& w, string_view s) {
+        static const char hex[] = "0123456789abcdef";
+        w.put('"');
+        size_t from = 0;
+        for (size_t i = 0; i < s.size(); i++) {
+            unsigned char ch = (unsigned char)s[i];
+            if (ch >= 0x20 && ch != '"' && ch != '\\') continue;
+            w.append(s.substr(from, i - from));
+            w.put('\\');
+            if (ch == '"' || ch == '\\') w.put((char)ch);
+            else if (ch == '\n') w.put('n');
+            else if (ch == '\t') w.put('t');
+            else if (ch == '\r') w.put('r');
+            else {
+                w.append("u00", 3);
+                w.put(hex[ch >> 4]);
+                w.put(hex[ch & 15]);
+            }
+            from = i + 1;
+        }
+        w.append(s.substr(from));
+        w.put('"');
+    }
+
+    void writeCsv(const Table& t, ChunkWriter& w) const {
+        for (size_t c = 0; c < t.columns.size(); c++) {
+            if (c > 0) w.put(',');
+            w.append(t.columns[c].name);
+        }
+        w.put('\n');
+        for (int r = 0; r < t.rows; r++) {
+            for (size_t c = 0; c < t.columns.size(); c++) {
+                const Column& col = t.columns[c];
+                if (c > 0) w.put(',');
+                if (col.kind == Column::INT) w.number(col.number(r));
+                else if (col.kind == Column::TEXT) csvText(w, col.text(r));
+                else {
+                    auto range = col.list(r);
+                    for (const int* v = range.first; v != range.second; ++v) {
+                        if (v != range.first) w.put(';');
+                        w.number(*v);
+                    }
+                }
+            }
+            w.put('\n');
+        }
+    }
+
+    void writeJsonLines(const Table& t, ChunkWriter& w) const {
+        for (int r = 0; r < t.rows; r++) {
+            w.put('{');
+            for (size_t c = 0; c < t.columns.size(); c++) {
+                const Column& col = t.columns[c];
+                if (c > 0) w.put(',');
+                jsonText(w, col.name);
+                w.put(':');
+                if (col.kind == Column::INT) w.number(col.number(r));
+                else if (col.kind == Column::TEXT) jsonText(w, col.text(r));
+                else {
+                    w.put('[');
+                    auto range = col.list(r);
+                    for (const int* v = range.first; v != range.second; ++v) {
+                        if (v != range.first) w.put(',');
+                        w.number(*v);
+                    }
+                    w.put(']');
+                }
+            }
+            w.append("}\n", 2);
+        }
+    }
+
+    static FlatBuilder::Ref arrowField(FlatBuilder& fb, const string& name, ArrowType type,
+        const vector<FlatBuilder::Ref>& children) {
+        fb.startTable();
+        if (type == ARROW_INT) {
+            fb.addScalar<int>(0, 32);
+            fb.addScalar<unsigned char>(1, 1);
+        }
+        FlatBuilder::Ref typeRef = fb.endTable();
+        FlatBuilder::Ref nameRef = fb.text(name);
+        FlatBuilder::Ref childRef = fb.refVector(children);
+        fb.startTable();
+        fb.addRef(0, nameRef);
+        fb.addScalar<unsigned char>(1, 0);
+        fb.addScalar<unsigned char>(2, (unsigned char)type);
+        fb.addRef(3, typeRef);
+        fb.addRef(5, childRef);
+        return fb.endTable();
+    }
+
+    static string arrowMessage(FlatBuilder& fb, MessageType type, FlatBuilder::Ref header, long long bodyLength) {
+        fb.startTable();
+        fb.addScalar<long long>(3, bodyLength);
+        fb.addRef(2, header);
+        fb.addScalar<short>(0, METADATA_V5);
+        fb.addScalar<unsigned char>(1, (unsigned char)type);
+        return fb.finish(fb.endTable());
+    }
+
+    // Encapsulated message: continuation marker, metadata length, metadata
+    static void writeMessage(ChunkWriter& w, const string& metadata) {
+        w.int32(-1);
+        w.int32((int)metadata.size());
+        w.append(metadata);
+    }
+
+    void writeSchema(const Table& t, ChunkWriter& w) const {
+        FlatBuilder fb;
+        vector<FlatBuilder::Ref> fields;
+        for (const auto& col : t.columns) {
+            vector<FlatBuilder::Ref> children;
+            if (col.kind == Column::INT_LIST) children.push_back(arrowField(fb, "item", ARROW_INT, {}));
+            ArrowType type = col.kind == Column::INT ? ARROW_INT : col.kind == Column::TEXT ? ARROW_UTF8 : ARROW_LIST;
+            fields.push_back(arrowField(fb, col.name, type, children));
+        }
+        FlatBuilder::Ref fieldRef = fb.refVector(fields);
+        fb.startTable();
+        fb.addScalar<short>(0, 0);
+        fb.addRef(1, fieldRef);
+        writeMessage(w, arrowMessage(fb, MESSAGE_SCHEMA, fb.endTable(), 0));
+    }
+
+    // Nothing is null, so every validity buffer is empty. Buffers are laid
+    // out in column order, each padded to 8 bytes.
+    void writeBatch(const Table& t, int first, int last, ChunkWriter& w) const {
+        long long n = last - first;
+        vector<pair<long long, long long>> nodes;
+        vector<pair<long long, long long>> buffers;
+        long long body = 0;
+        auto addBuffer = [&](long long length) {
+            buffers.push_back({ body, length });
+            body += padded(length);
+        };
+        for (const auto& col : t.columns) {
+            nodes.push_back({ n, 0 });
+            addBuffer(0);
+            if (col.kind == Column::INT) {
+                addBuffer(4 * n);
+            }
+            else if (col.kind == Column::TEXT) {
+                long long bytes = 0;
+                for (int r = first; r < last; r++) bytes += col.text(r).size();
+                addBuffer(4 * (n + 1));
+                addBuffer(bytes);
+            }
+            else {
+                long long values = 0;
+                for (int r = first; r < last; r++) values += col.list(r).second - col.list(r).first;
+                addBuffer(4 * (n + 1));
+                nodes.push_back({ values, 0 });
+                addBuffer(0);
+                addBuffer(4 * values);
+            }
+        }
+
+        FlatBuilder fb;
+        FlatBuilder::Ref bufferRef = fb.pairVector(buffers);
+        FlatBuilder::Ref nodeRef = fb.pairVector(nodes);
+        fb.startTable();
+        fb.addScalar<long long>(0, n);
+        fb.addRef(1, nodeRef);
+        fb.addRef(2, bufferRef);
+        writeMessage(w, arrowMessage(fb, MESSAGE_RECORD_BATCH, fb.endTable(), body));
+
+        size_t next = 0;
+        auto finishBuffer = [&]() {
+            w.zeros((size_t)(padded(buffers[next].second) - buffers[next].second));
+            next++;
+        };
+        for (const auto& col : t.columns) {
+            next++;
+            if (col.kind == Column::INT) {
+                for (int r = first; r < last; r++) w.int32(col.number(r));
+                finishBuffer();
+            }
+            else if (col.kind == Column::TEXT) {
+                int offset = 0;
+                w.int32(0);
+                for (int r = first; r < last; r++) w.int32(offset += (int)col.text(r).size());
+                finishBuffer();
+                string_view run = col.textRun ? col.textRun(first, last) : string_view();
+                if (col.textRun && (int)run.size() == offset) w.borrow(run.data(), run.size());
+                else for (int r = first; r < last; r++) w.append(col.text(r));
+                finishBuffer();
+            }
+            else {
+                int offset = 0;
+                w.int32(0);
+                for (int r = first; r < last; r++) {
+                    auto range = col.list(r);
+                    w.int32(offset += (int)(range.second - range.first));
+                }
+                finishBuffer();
+                next++;
+                for (int r = first; r < last; r++) {
+                    auto range = col.list(r);
+                    w.append(reinterpret_cast<const char*>(range.first), (range.second - range.first) * sizeof(int));
+                }
+                finishBuffer();
+            }
+        }
+    }
+
+    int writeArrow(const Table& t, ChunkWriter& w) const {
+        writeSchema(t, w);
+        int batches = 0;
+        for (int first = 0; first < t.rows; first += batchRows) {
+            writeBatch(t, first, min(t.rows, first + batchRows), w);
+            batches++;
+        }
+        w.int32(-1);
+        w.int32(0);
+        return batches;
+    }
+
+public:
+    explicit DataExporter(ModelStore::Snapshot snapshot, int rowsPerBatch = 65536, size_t chunk = 1 << 20)
+        : model(std::move(snapshot)), batchRows(max(1, rowsPerBatch)), chunkBytes(chunk) {
+        buildTables();
+    }
+
+    DataExporter(const DataExporter&) = delete;
+    DataExporter& operator=(const DataExporter&) = delete;
+
+    const vector<Table>& getTables() const { return tables; }
+
+    static const char* extension(Format format) {
+        if (format == FORMAT_CSV) return ".csv";
+        if (format == FORMAT_JSONL) return ".jsonl";
+        return ".arrows";
+    }
+
+    Stats writeTable(const Table& t, Format format, ostream& out) const {
+        ChunkWriter w(out, chunkBytes);
+        Stats stats = { false, t.rows, 0, 0 };
+        if (format == FORMAT_CSV) writeCsv(t, w);
+        else if (format == FORMAT_JSONL) writeJsonLines(t, w);
+        else stats.batches = writeArrow(t, w);
+        stats.ok = w.close();
+        stats.bytes = w.bytesWritten();
+        return stats;
+    }
+
+    // One file per table: <base>_<table><extension>
+    bool exportAll(const string& base, Format format, vector<pair<string, Stats>>& written, string& error) const {
+        for (const auto& t : tables) {
+            string path = base + "_" + t.name + extension(format);
+            ofstream file(path, ios::binary);
+            if (!file.is_open()) {
+                error = "Could not open " + path + " for writing";
+                return false;
+            }
+            Stats stats = writeTable(t, format, file);
+            if (!stats.ok) {
+                error = "Write to " + path + " failed";
+                return false;
+            }
+            written.push_back({ path, stats });
+        }
+        return true;
+    }
+};
+
+class CLIInterface {
+private:
+    ModelStore& store;
+
+public:
+    CLIInterface(ModelStore& s) : store(s) {
+    }
+
+    void showWelcome() {
+        DisplayHelper::printHeader("MHM MANAGEMENT SYSTEM");
+        cout << "\n  Welcome to the Advanced University Management System\n";
+        cout << "  Powered by Discrete Mathematics Concepts\n";
+        cout << "\n  Available Modules:\n";
+        cout << "  - Functions & Mappings (with Inverse)\n";
+        cout << "  - Automated Proof Generation\n";
+        cout << "  - Consistency Checking (with Set Operations)\n";
+        cout << "  - Performance Benchmarking (Memoization & Custom Bitsets)\n";
+        cout << "  - Comprehensive Unit Testing\n\n";
+    }
+
+    void displayStatistics() {
+        ModelStore::Snapshot model = store.snapshot();
+        const CourseManager& cm = model->cm;
+        const PeopleManager& pm = model->pm;
+        const Relations& rel = model->rel;
+
+        DisplayHelper::printHeader("SYSTEM STATISTICS");
+
+        cout << "\nCurrent System Status (version " << model->version << "):\n";
+        cout << "  Total Courses:  " << cm.count() << "\n";
+        cout << "  Total Students: " << pm.getStudentCount() << "\n";
+        cout << "  Total Faculty:  " << pm.getFacultyCount() << "\n";
+        cout << "  Total Rooms:    " << pm.getRoomCount() << "\n";
+
+        int totalPrereqs = 0;
+        for (int i = 0; i < rel.getSize(); i++) {
+            for (int j = 0; j < rel.getSize(); j++) {
+                if (rel.getPrereq(i, j)) totalPrereqs++;
+            }
+        }
+        cout << "  Prerequisites:  " << totalPrereqs << "\n";
+
+        cout << "\nAssignments:\n";
+        cout << "  Course-Faculty: " << model->courseToFaculty.size() << " mappings\n";
+        cout << "  Course-Room:    " << model->courseToRoom.size() << " mappings\n";
+        cout << "  Faculty-Room:   " << model->facultyToRoom.size() << " mappings\n";
+
+        cout << "  Enrollments:    " << pm.getEnrollmentCount() << " total\n";
+        cout << "\n";
+    }
+
+    void quickSetup() {
+        DisplayHelper::printHeader("QUICK SETUP WIZARD");
+
+        cout << "\nThis will create sample data for testing.\n";
+        cout << "Continue? (y/n): ";
+        char confirm;
+        cin >> confirm;
+
+        if (confirm != 'y' && confirm != 'Y') return;
+
+        store.update([](UniversityModel& m) {
+            cout << "\nCreating sample courses...\n";
+            m.cm.addCourse("CS101", "Programming", 3);
+            m.cm.addCourse("CS102", "DataStructures", 4);
+            m.cm.addCourse("CS201", "Algorithms", 4);
+            m.cm.addCourse("MATH101", "Calculus", 3);
+
+            m.rel.ensureSize(4);
+            m.rel.addPrereq(0, 1);
+            m.rel.addPrereq(1, 2);
+
+            cout << "Creating sample students...\n";
+            m.pm.addStudent("Ali");
+            m.pm.addStudent("Nimra");
+            m.pm.addStudent("Maria");
+
+            cout << "Creating sample faculty...\n";
+            m.pm.addFaculty("Dr. Kashaf");
+            m.pm.addFaculty("Dr. Noor");
+
+            cout << "Creating sample rooms...\n";
+            m.pm.addRoom("R101", 50);
+            m.pm.addRoom("R102", 40);
+
+            cout << "Assigning faculty and rooms...\n";
+            m.courseToFaculty.insert(0, 0);
+            m.courseToFaculty.insert(1, 0);
+            m.courseToFaculty.insert(2, 1);
+            m.courseToFaculty.insert(3, 1);
+
+            m.courseToRoom.insert(0, 0);
+            m.courseToRoom.insert(1, 0);
+            m.courseToRoom.insert(2, 1);
+            m.courseToRoom.insert(3, 1);
+
+            m.facultyToRoom.insert(0, 0);
+            m.facultyToRoom.insert(1, 1);
+
+            cout << "Enrolling students...\n";
+            auto s1 = m.pm.getStudent(0);
+            if (s1) {
+                s1->enrolled.push_back(0);
+                s1->enrolled.push_back(3);
+            }
+
+            auto s2 = m.pm.getStudent(1);
+            if (s2) {
+                s2->enrolled.push_back(0);
+                s2->enrolled.push_back(1);
+            }
+            return true;
+        });
+
+        DisplayHelper::printSuccess("Quick setup completed!");
+        displayStatistics();
+    }
+
+    // Writes every table of the current snapshot to <base>_<table>.<ext>;
+    // format is csv, jsonl, arrow or all
+    void exportData(const string& base, const string& format) {
+        vector<DataExporter::Format> formats;
+        if (format == "csv" || format == "all") formats.push_back(DataExporter::FORMAT_CSV);
+        if (format == "jsonl" || format == "all") formats.push_back(DataExporter::FORMAT_JSONL);
+        if (format == "arrow" || format == "all") formats.push_back(DataExporter::FORMAT_ARROW);
+        if (formats.empty()) {
+            DisplayHelper::printError("Unknown format: " + format + " (use csv, jsonl, arrow or all)");
+            return;
+        }
+
+        DataExporter exporter(store.snapshot());
+        auto start = chrono::steady_clock::now();
+        vector<pair<string, DataExporter::Stats>> written;
+        for (auto f : formats) {
+            string error;
+            if (!exporter.exportAll(base, f, written, error)) {
+                DisplayHelper::printError(error);
+                return;
+            }
+        }
+        auto ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+        cout << "\n";
+        for (const auto& file : written) {
+            cout << "  " << left << setw(40) << file.first << right << setw(10) << file.second.rows
+                << " rows" << setw(14) << file.second.bytes << " bytes\n";
+        }
+        cout << left;
+        DisplayHelper::printSuccess("Exported " + to_string(written.size()) + " files in " + to_string(ms) + " ms");
+    }
+
+    void showHelp() {
+        DisplayHelper::printHeader("HELP & DOCUMENTATION");
+
+        cout << "\nMODULE 7 - Functions:\n";
+        cout << "  Tests function properties (injective, surjective, bijective)\n";
+        cout << "  NEW: Inverse mappings, multi-valued functions\n";
+
+        cout << "\nMODULE 8 - Automated Proofs:\n";
+        cout << "  Generates formal mathematical proofs\n";
+        cout << "  NEW: Course chains, acyclic proofs, logic rules\n";
+
+        cout << "\nMODULE 9 - Consistency Checker:\n";
+        cout << "  Detects system-wide conflicts\n";
+        cout << "  NEW: Set intersection operations\n";
+
+        cout << "\nMODULE 10 - Performance:\n";
+        cout << "  Benchmarks algorithm efficiency\n";
+        cout << "  NEW: Memoization, recursion, custom bitsets\n";
+
+        cout << "\nMODULE 12 - Unit Testing:\n";
+        cout << "  Comprehensive test suite\n";
+        cout << "  NEW: Large-scale FAST University tests\n\n";
+    }
+};
+
+// Power-of-two latency buckets in microseconds: bucket b counts samples in
+// [2^(b-1), 2^b). Recording is lock-free so workers share one per command.
+class LatencyHistogram {
+private:
+    static const int BUCKETS = 40;
+    atomic<unsigned long long> counts[BUCKETS];
+
+public:
+    LatencyHistogram() {
+        for (auto& c : counts) c.store(0);
+    }
+
+    void record(long long micros) {
+        int bucket = 0;
+        while (micros > 0 && bucket < BUCKETS - 1) {
+            micros >>= 1;
+            bucket++;
+        }
+        counts[bucket].fetch_add(1, memory_order_relaxed);
+    }
+
+    unsigned long long count() const {
+        unsigned long long total = 0;
+        for (const auto& c : counts) total += c.load(memory_order_relaxed);
+        return total;
+    }
+
+    // Upper bound of the bucket holding the given quantile, in microseconds
+    long long percentile(double q) const {
+        unsigned long long total = count();
+        if (total == 0) return 0;
+        unsigned long long seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            seen += counts[b].load(memory_order_relaxed);
+            if (seen >= q * total) return 1LL << b;
+        }
+        return 1LL << (BUCKETS - 1);
+    }
+
+    string summary() const {
+        stringstream ss;
+        ss << "n=" << count() << " p50<" << percentile(0.5) << "us p90<" << percentile(0.9)
+            << "us p99<" << percentile(0.99) << "us max<" << percentile(1.0) << "us";
+        return ss.str();
+    }
+};
+
+// Fixed set of threads draining one job queue
+class WorkerPool {
+private:
+    vector<thread> workers;
+    deque<function<void()>> jobs;
+    mutex lock;
+    condition_variable ready;
+    bool stopping;
+
+    void run() {
+        while (true) {
+            function<void()> job;
+            {
+                unique_lock<mutex> guard(lock);
+                ready.wait(guard, [this]() { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+public:
+    explicit WorkerPool(int threads) : stopping(false) {
+        for (int i = 0; i < max(1, threads); i++) {
+            workers.push_back(thread([this]() { run(); }));
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(function<void()> job) {
+        {
+            lock_guard<mutex> guard(lock);
+            jobs.push_back(std::move(job));
+        }
+        ready.notify_one();
+    }
+
+    int size() const { return workers.size(); }
+};
+
+// Non-interactive front end: line-delimited commands in, one reply per
+// command out ("OK ..." or "ERR ...", reads may add detail lines first).
+// Each batch of lines is answered in order. Consecutive writes are applied
+// together as one published version; a read waits only for the writes ahead
+// of it, then runs on the worker pool against its own snapshot.
+class RequestServer {
+public:
+    enum CommandKind {
+        CMD_ADD_COURSE, CMD_ADD_STUDENT, CMD_ADD_FACULTY, CMD_ADD_ROOM,
+        CMD_ADD_PREREQ, CMD_ASSIGN_FACULTY, CMD_ASSIGN_ROOM, CMD_ENROLL,
+        CMD_STATS, CMD_CHECK, CMD_PROOF, CMD_LATENCY, CMD_UNKNOWN,
+        CMD_KINDS
+    };
+
+private:
+    typedef chrono::steady_clock Clock;
 
-        displayResults();
-        cache.displayStats();
-    }
+    struct Command {
+        CommandKind kind;
+        vector<string> args;
+        Clock::time_point received;
+    };
 
-    void displayResults() const {
-        DisplayHelper::printHeader("BENCHMARK RESULTS");
+    // Counts outstanding pool jobs for one batch
+    struct Outstanding {
+        mutex lock;
+        condition_variable done;
+        int jobs = 0;
 
-        cout << "\n" << left << setw(40) << "Operation"
-            << setw(12) << "Time (ms)"
-            << setw(10) << "Size"
-            << "Complexity\n";
-        cout << string(75, '-') << "\n";
+        void add() {
+            lock_guard<mutex> guard(lock);
+            jobs++;
+        }
 
-        for (const auto& r : results) {
-            cout << left << setw(40) << r.operation
-                << setw(12) << r.milliseconds
-                << setw(10) << r.dataSize
-                << r.complexity << "\n";
+        void finish() {
+            lock_guard<mutex> guard(lock);
+            if (--jobs == 0) done.notify_all();
         }
 
-        cout << "\nNote: ms = milliseconds, w = word size (typically 64 bits)\n";
+        void wait() {
+            unique_lock<mutex> guard(lock);
+            done.wait(guard, [this]() { return jobs == 0; });
+        }
+    };
+
+    ModelStore& store;
+    WorkerPool pool;
+    LatencyHistogram latency[CMD_KINDS];
+
+    static const char* kindName(CommandKind kind) {
+        static const char* names[CMD_KINDS] = {
+            "addCourse", "addStudent", "addFaculty", "addRoom",
+            "addPrereq", "assignFaculty", "assignRoom", "enroll",
+            "stats", "check", "proof", "latency", "unknown"
+        };
+        return names[kind];
     }
-};
 
-class CLIInterface {
-private:
-    CourseManager& cm;
-    PeopleManager& pm;
-    Relations& rel;
-    CustomMap<int, int>& courseToFaculty;
-    CustomMap<int, int>& courseToRoom;
-    CustomMap<int, int> facultyToRoom;
+    static bool isWrite(CommandKind kind) {
+        return kind <= CMD_ENROLL;
+    }
 
-public:
-    CLIInterface(CourseManager& c, PeopleManager& p, Relations& r,
-        CustomMap<int, int>& cf, CustomMap<int, int>& cr)
-        : cm(c), pm(p), rel(r), courseToFaculty(cf), courseToRoom(cr) {
+    static bool toInt(const string& text, int& value) {
+        if (text.empty()) return false;
+        char* end = nullptr;
+        long parsed = strtol(text.c_str(), &end, 10);
+        if (*end != '\0' || parsed < INT_MIN || parsed > INT_MAX) return false;
+        value = (int)parsed;
+        return true;
     }
 
-    void showWelcome() {
-        DisplayHelper::printHeader("MHM MANAGEMENT SYSTEM");
-        cout << "\n  Welcome to the Advanced University Management System\n";
-        cout << "  Powered by Discrete Mathematics Concepts\n";
-        cout << "\n  Available Modules:\n";
-        cout << "  - Functions & Mappings (with Inverse)\n";
-        cout << "  - Automated Proof Generation\n";
-        cout << "  - Consistency Checking (with Set Operations)\n";
-        cout << "  - Performance Benchmarking (Memoization & Custom Bitsets)\n";
-        cout << "  - Comprehensive Unit Testing\n\n";
+    static Command parse(const string& line) {
+        Command cmd;
+        cmd.kind = CMD_UNKNOWN;
+        cmd.received = Clock::now();
+
+        stringstream ss(line);
+        string word;
+        ss >> word;
+        for (int k = 0; k < CMD_UNKNOWN; k++) {
+            if (word == kindName((CommandKind)k)) cmd.kind = (CommandKind)k;
+        }
+        if (cmd.kind == CMD_UNKNOWN) cmd.args.push_back(word);
+
+        string arg;
+        while (ss >> arg) cmd.args.push_back(arg);
+        return cmd;
     }
 
-    void displayStatistics() {
-        DisplayHelper::printHeader("SYSTEM STATISTICS");
+    // Parses the first n arguments as integers
+    static bool intArgs(const Command& cmd, size_t n, int* out) {
+        if (cmd.args.size() < n) return false;
+        for (size_t i = 0; i < n; i++) {
+            if (!toInt(cmd.args[i], out[i])) return false;
+        }
+        return true;
+    }
 
-        cout << "\nCurrent System Status:\n";
-        cout << "  Total Courses:  " << cm.count() << "\n";
-        cout << "  Total Students: " << pm.getStudentCount() << "\n";
-        cout << "  Total Faculty:  " << pm.getFacultyCount() << "\n";
-        cout << "  Total Rooms:    " << pm.getRoomCount() << "\n";
+    static bool applyWrite(UniversityModel& m, const Command& cmd, string& reply) {
+        int v[3];
+        const auto& a = cmd.args;
 
-        int totalPrereqs = 0;
-        for (int i = 0; i < rel.getSize(); i++) {
-            for (int j = 0; j < rel.getSize(); j++) {
-                if (rel.getPrereq(i, j)) totalPrereqs++;
+        switch (cmd.kind) {
+        case CMD_ADD_COURSE: {
+            if (a.size() != 3 || !toInt(a[2], v[0])) break;
+            int id = m.cm.addCourse(a[0], a[1], v[0]);
+            m.rel.ensureSize(m.cm.count());
+            reply = "OK " + to_string(id);
+            return true;
+        }
+        case CMD_ADD_STUDENT:
+            if (a.size() != 1) break;
+            reply = "OK " + to_string(m.pm.addStudent(a[0]));
+            return true;
+        case CMD_ADD_FACULTY:
+            if (a.size() != 1) break;
+            reply = "OK " + to_string(m.pm.addFaculty(a[0]));
+            return true;
+        case CMD_ADD_ROOM: {
+            v[0] = 30;
+            if (a.empty() || a.size() > 2 || (a.size() == 2 && !toInt(a[1], v[0]))) break;
+            reply = "OK " + to_string(m.pm.addRoom(a[0], v[0]));
+            return true;
+        }
+        case CMD_ADD_PREREQ:
+            if (a.size() != 2 || !intArgs(cmd, 2, v)) break;
+            if (v[0] < 0 || v[0] >= m.cm.count() || v[1] < 0 || v[1] >= m.cm.count()) {
+                reply = "ERR invalid course IDs";
+                return false;
+            }
+            m.rel.addPrereq(v[0], v[1]);
+            reply = "OK";
+            return true;
+        case CMD_ASSIGN_FACULTY: {
+            if (a.size() != 2 || !intArgs(cmd, 2, v)) break;
+            auto* fac = m.pm.getFaculty(v[1]);
+            if (v[0] < 0 || v[0] >= m.cm.count() || !fac) {
+                reply = "ERR invalid IDs";
+                return false;
             }
+            m.courseToFaculty.insert(v[0], v[1]);
+            fac->courses.push_back(v[0]);
+            reply = "OK";
+            return true;
+        }
+        case CMD_ASSIGN_ROOM:
+            if (a.size() != 2 || !intArgs(cmd, 2, v)) break;
+            if (v[0] < 0 || v[0] >= m.cm.count() || v[1] < 0 || v[1] >= m.pm.getRoomCount()) {
+                reply = "ERR invalid IDs";
+                return false;
+            }
+            m.courseToRoom.insert(v[0], v[1]);
+            reply = "OK";
+            return true;
+        case CMD_ENROLL: {
+            if (a.size() != 2 || !intArgs(cmd, 2, v)) break;
+            auto student = m.pm.getStudent(v[0]);
+            if (!student || v[1] < 0 || v[1] >= m.cm.count()) {
+                reply = "ERR invalid IDs";
+                return false;
+            }
+            if (student->enrolled.contains(v[1])) {
+                reply = "ERR already enrolled";
+                return false;
+            }
+            student->enrolled.push_back(v[1]);
+            reply = "OK";
+            return true;
+        }
+        default:
+            break;
         }
-        cout << "  Prerequisites:  " << totalPrereqs << "\n";
 
-        cout << "\nAssignments:\n";
-        cout << "  Course-Faculty: " << courseToFaculty.size() << " mappings\n";
-        cout << "  Course-Room:    " << courseToRoom.size() << " mappings\n";
-        cout << "  Faculty-Room:   " << facultyToRoom.size() << " mappings\n";
+        reply = "ERR usage: " + usage(cmd.kind);
+        return false;
+    }
 
-        int totalEnrollments = 0;
-        for (int i = 0; i < pm.getStudentCount(); i++) {
-            auto* s = pm.getStudent(i);
-            if (s) totalEnrollments += s->enrolled.size();
+    static string usage(CommandKind kind) {
+        switch (kind) {
+        case CMD_ADD_COURSE: return "addCourse <code> <name> <credits>";
+        case CMD_ADD_STUDENT: return "addStudent <name>";
+        case CMD_ADD_FACULTY: return "addFaculty <name>";
+        case CMD_ADD_ROOM: return "addRoom <name> [capacity]";
+        case CMD_ADD_PREREQ: return "addPrereq <course> <dependent course>";
+        case CMD_ASSIGN_FACULTY: return "assignFaculty <course> <faculty>";
+        case CMD_ASSIGN_ROOM: return "assignRoom <course> <room>";
+        case CMD_ENROLL: return "enroll <student> <course>";
+        case CMD_PROOF: return "proof [text|json|dot|verdict] <course> [completed course...]";
+        default: return kindName(kind);
         }
-        cout << "  Enrollments:    " << totalEnrollments << " total\n";
-        cout << "\n";
     }
 
-    void quickSetup() {
-        DisplayHelper::printHeader("QUICK SETUP WIZARD");
+    string runRead(const UniversityModel& m, const Command& cmd) const {
+        stringstream out;
 
-        cout << "\nThis will create sample data for testing.\n";
-        cout << "Continue? (y/n): ";
-        char confirm;
-        cin >> confirm;
+        switch (cmd.kind) {
+        case CMD_STATS: {
+            int prereqs = 0;
+            for (const auto& row : m.rel.getPrereqMatrix()) {
+                prereqs += count(row.begin(), row.end(), true);
+            }
+            out << "OK version=" << m.version << " courses=" << m.cm.count()
+                << " students=" << m.pm.getStudentCount() << " faculty=" << m.pm.getFacultyCount()
+                << " rooms=" << m.pm.getRoomCount() << " prereqs=" << prereqs
+                << " enrollments=" << m.pm.getEnrollmentCount();
+            break;
+        }
+        case CMD_CHECK: {
+            ConsistencyChecker checker(m.cm, m.pm, m.rel, m.courseToFaculty, m.courseToRoom);
+            checker.runAllChecks();
+            for (const auto& e : checker.getErrors()) out << "error " << e << "\n";
+            for (const auto& w : checker.getWarnings()) out << "warning " << w << "\n";
+            out << "OK version=" << m.version << " errors=" << checker.getErrors().size()
+                << " warnings=" << checker.getWarnings().size();
+            break;
+        }
+        case CMD_PROOF: {
+            // Optional leading format: text (default), json, dot or verdict
+            size_t first = 0;
+            string format = "text";
+            if (!cmd.args.empty() && (cmd.args[0] == "text" || cmd.args[0] == "json"
+                || cmd.args[0] == "dot" || cmd.args[0] == "verdict")) {
+                format = cmd.args[0];
+                first = 1;
+            }
+            int courseId;
+            if (cmd.args.size() <= first || !toInt(cmd.args[first], courseId)) {
+                out << "ERR usage: " << usage(CMD_PROOF);
+                break;
+            }
+            if (courseId < 0 || courseId >= m.cm.count()) {
+                out << "ERR invalid course ID";
+                break;
+            }
 
-        if (confirm != 'y' && confirm != 'Y') return;
+            vector<bool> completed(max(m.cm.count(), m.rel.getSize()), false);
+            for (size_t i = first + 1; i < cmd.args.size(); i++) {
+                int c;
+                if (toInt(cmd.args[i], c) && c >= 0 && c < (int)completed.size()) completed[c] = true;
+            }
 
-        cout << "\nCreating sample courses...\n";
-        cm.addCourse("CS101", "Programming", 3);
-        cm.addCourse("CS102", "DataStructures", 4);
-        cm.addCourse("CS201", "Algorithms", 4);
-        cm.addCourse("MATH101", "Calculus", 3);
+            ProofGenerator proof(m.rel, m.cm);
+            bool holds;
+            if (format == "verdict") holds = proof.prereqVerdict(courseId, completed);
+            else {
+                proof.generatePrereqProof(courseId, completed);
+                holds = proof.holds();
+                if (format == "json") proof.writeJson(out);
+                else if (format == "dot") proof.writeDot(out);
+                else proof.writeText(out, false);
+            }
+            out << "OK " << (holds ? "proved" : "not proved");
+            break;
+        }
+        case CMD_LATENCY:
+            out << latencyReport() << "OK";
+            break;
+        default:
+            out << "ERR not a read command";
+            break;
+        }
+        return out.str();
+    }
 
-        rel.ensureSize(4);
-        rel.addPrereq(0, 1);
-        rel.addPrereq(1, 2);
+    void finish(const Command& cmd) {
+        auto elapsed = chrono::duration_cast<chrono::microseconds>(Clock::now() - cmd.received);
+        latency[cmd.kind].record(elapsed.count());
+    }
 
-        cout << "Creating sample students...\n";
-        pm.addStudent("Ali");
-        pm.addStudent("Nimra");
-        pm.addStudent("Maria");
+    // Applies the queued writes as one update, so they cost a single copy of
+    // the model and become visible together
+    void flushWrites(const vector<Command>& commands, vector<int>& pending, vector<string>& replies) {
+        if (pending.empty()) return;
 
-        cout << "Creating sample faculty...\n";
-        pm.addFaculty("Dr. Kashaf");
-        pm.addFaculty("Dr. Noor");
+        store.update([&](UniversityModel& m) {
+            bool changed = false;
+            for (int i : pending) {
+                if (applyWrite(m, commands[i], replies[i])) changed = true;
+            }
+            return changed;
+        });
 
-        cout << "Creating sample rooms...\n";
-        pm.addRoom("R101", 50);
-        pm.addRoom("R102", 40);
+        for (int i : pending) finish(commands[i]);
+        pending.clear();
+    }
 
-        cout << "Assigning faculty and rooms...\n";
-        courseToFaculty.insert(0, 0);
-        courseToFaculty.insert(1, 0);
-        courseToFaculty.insert(2, 1);
-        courseToFaculty.insert(3, 1);
+public:
+    explicit RequestServer(ModelStore& s, int threads = 0)
+        : store(s), pool(threads > 0 ? threads : max(1u, thread::hardware_concurrency())) {
+    }
 
-        courseToRoom.insert(0, 0);
-        courseToRoom.insert(1, 0);
-        courseToRoom.insert(2, 1);
-        courseToRoom.insert(3, 1);
+    // Answers a batch of commands; replies[i] belongs to lines[i]
+    vector<string> process(const vector<string>& lines) {
+        vector<Command> commands;
+        commands.reserve(lines.size());
+        for (const auto& line : lines) commands.push_back(parse(line));
 
-        facultyToRoom.insert(0, 0);
-        facultyToRoom.insert(1, 1);
+        vector<string> replies(lines.size());
+        vector<int> pendingWrites;
+        Outstanding outstanding;
 
-        cout << "Enrolling students...\n";
-        auto* s1 = pm.getStudent(0);
-        if (s1) {
-            s1->enrolled.push_back(0);
-            s1->enrolled.push_back(3);
-        }
+        for (int i = 0; i < (int)commands.size(); i++) {
+            if (isWrite(commands[i].kind)) {
+                pendingWrites.push_back(i);
+                continue;
+            }
+
+            flushWrites(commands, pendingWrites, replies);
+            if (commands[i].kind == CMD_UNKNOWN) {
+                replies[i] = "ERR unknown command: " + commands[i].args[0];
+                finish(commands[i]);
+                continue;
+            }
 
-        auto* s2 = pm.getStudent(1);
-        if (s2) {
-            s2->enrolled.push_back(0);
-            s2->enrolled.push_back(1);
+            ModelStore::Snapshot snapshot = store.snapshot();
+            outstanding.add();
+            pool.submit([this, snapshot, &commands, &replies, &outstanding, i]() {
+                replies[i] = runRead(*snapshot, commands[i]);
+                finish(commands[i]);
+                outstanding.finish();
+            });
         }
 
-        DisplayHelper::printSuccess("Quick setup completed!");
-        displayStatistics();
+        flushWrites(commands, pendingWrites, replies);
+        outstanding.wait();
+        return replies;
     }
 
-    CustomMap<int, int>& getFacultyToRoom() {
-        return facultyToRoom;
+    // Reads commands until end of input. Lines already buffered are taken
+    // together (up to batchSize), so piped scripts are batched while an
+    // interactive client still gets each reply straight away.
+    long long serveStream(istream& in, ostream& out, size_t batchSize = 1024) {
+        long long served = 0;
+        string line;
+        vector<string> batch;
+
+        while (getline(in, line)) {
+            addLine(line, batch);
+            if (batch.size() < batchSize && in.rdbuf()->in_avail() > 0) continue;
+
+            for (const auto& reply : process(batch)) out << reply << "\n";
+            out.flush();
+            served += batch.size();
+            batch.clear();
+        }
+
+        for (const auto& reply : process(batch)) out << reply << "\n";
+        out.flush();
+        return served + batch.size();
     }
 
-    void exportData(const string& filename) {
-        ofstream file(filename);
-        if (!file.is_open()) {
-            DisplayHelper::printError("Could not open file for writing");
-            return;
+    // Accepts clients on a Unix socket, one thread per connection; runs
+    // until the process is stopped
+    bool serveSocket(const string& path) {
+#if !defined(_WIN32)
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            DisplayHelper::printError("Socket path too long");
+            return false;
         }
+        copy(path.begin(), path.end(), addr.sun_path);
 
-        file << "MHM DATA EXPORT\n";
-        file << "===========================\n\n";
+        int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) {
+            DisplayHelper::printError("Could not create socket");
+            return false;
+        }
 
-        file << "COURSES:\n";
-        for (int i = 0; i < cm.count(); i++) {
-            auto* c = cm.getCourse(i);
-            if (c) {
-                file << c->id << "," << c->code << "," << c->name << "," << c->credits << "\n";
-            }
+        unlink(path.c_str());
+        if (bind(listener, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listener, 64) < 0) {
+            DisplayHelper::printError("Could not listen on " + path);
+            close(listener);
+            return false;
         }
 
-        file << "\nSTUDENTS:\n";
-        for (int i = 0; i < pm.getStudentCount(); i++) {
-            auto* s = pm.getStudent(i);
-            if (s) {
-                file << s->id << "," << s->name << ",";
-                for (size_t j = 0; j < s->enrolled.size(); j++) {
-                    file << s->enrolled[j];
-                    if (j < s->enrolled.size() - 1) file << ";";
-                }
-                file << "\n";
+        signal(SIGPIPE, SIG_IGN);
+        cerr << "Listening on " << path << " with " << pool.size() << " workers\n";
+
+        while (true) {
+            int client = accept(listener, nullptr, nullptr);
+            if (client < 0) {
+                if (errno == EINTR) continue;
+                break;
             }
+            thread([this, client]() { serveConnection(client); }).detach();
         }
 
-        file.close();
-        DisplayHelper::printSuccess("Data exported to " + filename);
+        close(listener);
+        unlink(path.c_str());
+        return true;
+#else
+        DisplayHelper::printError("Socket mode needs a Unix platform; use --batch");
+        return false;
+#endif
     }
 
-    void showHelp() {
-        DisplayHelper::printHeader("HELP & DOCUMENTATION");
-
-        cout << "\nMODULE 7 - Functions:\n";
-        cout << "  Tests function properties (injective, surjective, bijective)\n";
-        cout << "  NEW: Inverse mappings, multi-valued functions\n";
+    string latencyReport() const {
+        stringstream ss;
+        for (int k = 0; k < CMD_KINDS; k++) {
+            if (latency[k].count() == 0) continue;
+            ss << "latency " << kindName((CommandKind)k) << " " << latency[k].summary() << "\n";
+        }
+        return ss.str();
+    }
 
-        cout << "\nMODULE 8 - Automated Proofs:\n";
-        cout << "  Generates formal mathematical proofs\n";
-        cout << "  NEW: Course chains, acyclic proofs, logic rules\n";
+    const LatencyHistogram& getLatency(CommandKind kind) const {
+        return latency[kind];
+    }
 
-        cout << "\nMODULE 9 - Consistency Checker:\n";
-        cout << "  Detects system-wide conflicts\n";
-        cout << "  NEW: Set intersection operations\n";
+private:
+    static void addLine(string line, vector<string>& batch) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.find_first_not_of(" \t") != string::npos) batch.push_back(line);
+    }
 
-        cout << "\nMODULE 10 - Performance:\n";
-        cout << "  Benchmarks algorithm efficiency\n";
-        cout << "  NEW: Memoization, recursion, custom bitsets\n";
+#if !defined(_WIN32)
+    void serveConnection(int fd) {
+        string buffer;
+        char chunk[65536];
+
+        while (true) {
+            ssize_t n = read(fd, chunk, sizeof(chunk));
+            if (n <= 0) break;
+            buffer.append(chunk, n);
+
+            // Every complete line received so far forms one batch
+            vector<string> batch;
+            size_t start = 0, newline;
+            while ((newline = buffer.find('\n', start)) != string::npos) {
+                addLine(buffer.substr(start, newline - start), batch);
+                start = newline + 1;
+            }
+            buffer.erase(0, start);
+            if (batch.empty()) continue;
 
-        cout << "\nMODULE 12 - Unit Testing:\n";
-        cout << "  Comprehensive test suite\n";
-        cout << "  NEW: Large-scale FAST University tests\n\n";
+            string out;
+            for (const auto& reply : process(batch)) {
+                out += reply;
+                out += '\n';
+            }
+            for (size_t sent = 0; sent < out.size();) {
+                ssize_t w = write(fd, out.data() + sent, out.size() - sent);
+                if (w <= 0) {
+                    close(fd);
+                    return;
+                }
+                sent += w;
+            }
+        }
+        close(fd);
     }
+#endif
 };
 
 class UnitTesting {
@@ -1788,6 +3869,95 @@ public:
 
         proof.generateAcyclicProof();
         assertTrue(true, "Acyclic proof generated");
+
+        // Compact IDs use the owner array, wide ones the sorted fallback
+        for (int spread : { 1, 1000000 }) {
+            vector<CustomSet<int>> blocks(3);
+            for (int e = 0; e < 30; e++) blocks[e % 3].insert(e * spread);
+            blocks[2].insert(4 * spread);
+            blocks[2].insert(7 * spread);
+            blocks[1].insert(3 * spread);
+
+            proof.generatePartitionProof(blocks);
+            bool found = proof.stepCount() == 4 && proof.statement(1) == "Sets 0 and 1 overlap [FAIL]"
+                && proof.justification(1) == "Both contain " + to_string(3 * spread)
+                && proof.statement(2) == "Sets 1 and 2 overlap [FAIL]"
+                && proof.justification(2) == "Both contain " + to_string(4 * spread);
+            assertTrue(found, "Partition overlaps reported once per pair with a shared element");
+
+            // One element in three sets overlaps every pair of them
+            vector<CustomSet<int>> shared(3);
+            for (int i = 0; i < 3; i++) {
+                shared[i].insert(5 * spread);
+                shared[i].insert((10 + i) * spread);
+            }
+            proof.generatePartitionProof(shared);
+            bool everyPair = proof.stepCount() == 5;
+            const char* expected[] = { "Sets 0 and 1 overlap [FAIL]", "Sets 0 and 2 overlap [FAIL]", "Sets 1 and 2 overlap [FAIL]" };
+            for (int k = 0; k < 3 && everyPair; k++) {
+                everyPair = proof.statement(k + 1) == expected[k] && proof.justification(k + 1) == "Both contain " + to_string(5 * spread);
+            }
+            assertTrue(everyPair, "Element held by three sets reports all three pairs");
+        }
+
+        vector<CustomSet<int>> valid(4);
+        for (int e = 0; e < 20000; e++) valid[e % 4].insert(e);
+        proof.generatePartitionProof(valid);
+        assertTrue(proof.holds() && proof.statement(proof.stepCount() - 1).find("Valid partition") != string::npos,
+            "Disjoint blocks form a partition");
+
+        // Nodes render on demand; the tree nests each step under the
+        // nearest earlier step of a lower level
+        cm.addCourse("CS301 \"Sys\"", "Systems", 3);
+        rel.ensureSize(3);
+        rel.addPrereq(1, 2);
+        ProofGenerator chain(rel, cm);
+        chain.generatePrereqProof(2, completed);
+        assertTrue(!chain.holds() && !chain.prereqVerdict(2, completed) && chain.prereqVerdict(1, completed),
+            "Verdict fast path agrees with the full proof");
+        assertTrue(chain.statement(0) == "THEOREM: Student can enroll in CS301 \"Sys\"" && chain.step(2).parent == 1
+            && chain.step(chain.stepCount() - 1).parent == -1, "Proof steps form a tree");
+
+        stringstream text, json, dot;
+        chain.writeText(text, false);
+        chain.writeJson(json);
+        chain.writeDot(dot);
+        assertTrue(text.str().find("    CS201 is NOT completed [FAIL]\n") != string::npos
+            && text.str().find("Indirect prerequisite CS101 satisfied [PASS]") != string::npos, "Text rendering");
+        assertTrue(text.str().find("  TAKE NEXT: 1 of 1 missing courses are open now\n    CS201 can be taken now\n") != string::npos
+            && text.str().find("    Step 1: CS201\n    Step 2: CS301 \"Sys\"\n") != string::npos,
+            "Failed proof names the next course and the shortest path");
+
+        // 0 -> 1 -> 3, 2 -> 3, 4 -> 2, 5 -> 4, 0 done: only 1 and 5 are open
+        Relations graph;
+        graph.addPrereq(0, 1);
+        graph.addPrereq(1, 3);
+        graph.addPrereq(2, 3);
+        graph.addPrereq(4, 2);
+        graph.addPrereq(5, 4);
+        vector<bool> done(6, false);
+        done[0] = true;
+        auto why = graph.explainMissing(3, done);
+        assertTrue(!why.eligible && why.missing == vector<int>({ 1, 2, 4, 5 }) && why.frontier == vector<int>({ 1, 5 })
+            && why.path == vector<int>({ 1, 3 }), "Missing prerequisites reduce to a frontier and a shortest path");
+        done[1] = true;
+        why = graph.explainMissing(3, done);
+        assertTrue(why.frontier == vector<int>({ 5 }) && why.path == vector<int>({ 5, 4, 2, 3 }), "Path follows the remaining chain");
+        graph.addPrereq(2, 4);
+        graph.addPrereq(4, 5);
+        why = graph.explainMissing(3, done);
+        assertTrue(why.frontier.empty() && why.path.empty() && why.missing.size() == 3, "A missing cycle has no frontier");
+        assertTrue(json.str().find("{\"holds\":false,\"steps\":[{\"rule\":0,\"statement\":\"THEOREM: Student can enroll in CS301 \\\"Sys\\\"\"") == 0
+            && json.str().find("\"children\":[]}]},{\"rule\":5") != string::npos, "JSON rendering nests and escapes");
+        assertTrue(dot.str().find("  n1 -> n2;") != string::npos && dot.str().rfind("}\n") == dot.str().size() - 2,
+            "Graphviz rendering");
+
+        PeopleManager pm;
+        pm.addStudent("Ali");
+        pm.getStudent(0)->enrolled.push_back(2);
+        pm.getStudent(0)->completed.push_back(1);
+        auto unmet = chain.auditEnrollments(pm);
+        assertTrue(unmet.size() == 1 && unmet[0] == make_pair(0, 2), "Audit flags enrollments missing an indirect prerequisite");
     }
 
     void testConsistencyChecker() {
@@ -1830,6 +4000,296 @@ public:
         assertTrue(true, "Benchmark completed successfully");
     }
 
+    void testCustomBitset() {
+        cout << "\n--- Testing Custom Bitset ---\n";
+
+        CustomBitset a, b;
+        a.set(3); a.set(64); a.set(1500);
+        b.set(64); b.set(1500); b.set(2000);
+
+        assertTrue(a.size() == 1501 && a.test(1500), "Bitset grows past old 1000-bit limit");
+        assertEqual(a.count(), 3, "Popcount");
+        assertEqual((a & b).count(), 2, "Bitwise AND");
+        assertEqual((a | b).count(), 4, "Bitwise OR");
+        assertEqual((a ^ b).count(), 2, "Bitwise XOR");
+        assertEqual(a.andCount(b), 2, "AND cardinality");
+
+        CustomBitset diff = a;
+        diff.andNot(b);
+        assertTrue(diff.count() == 1 && diff.test(3), "AND-NOT");
+
+        assertEqual(a.findFirst(), 3, "Find first set bit");
+        assertEqual(a.findNext(4), 64, "Find next set bit");
+        assertEqual(a.findNext(1501), -1, "Find next past end");
+
+        int visited = 0;
+        a.forEach([&](int) { visited++; });
+        assertEqual(visited, 3, "Iterate set bits");
+
+        CustomBitset empty(10);
+        assertTrue(empty.none() && !empty.any(), "Empty bitset any/none");
+    }
+
+    void testOptimizedRelations() {
+        cout << "\n--- Testing Optimized Relations ---\n";
+
+        OptimizedRelations small;
+        small.addPrereq(0, 1);
+        small.addPrereq(1, 2);
+        assertTrue(small.getCapacity() < 1000, "Small catalog does not preallocate 1000 rows");
+
+        auto closure = small.closurePrereq();
+        assertTrue(closure.size() == 3 && closure[0].test(2), "Closure sized to course count");
+
+        OptimizedRelations large;
+        for (int i = 0; i < 1499; i++) {
+            large.addPrereq(i, i + 1);
+        }
+        assertTrue(large.getPrereq(1498, 1499), "Courses above 1000 are kept");
+        assertTrue(large.closurePrereq()[0].test(1499), "Closure across 1500 courses");
+        assertTrue(!large.hasPrereqCycle(), "Chain has no cycle");
+    }
+
+    void testStudentStore() {
+        cout << "\n--- Testing Student Store ---\n";
+
+        PeopleManager pm;
+        for (int i = 0; i < 1000; i++) {
+            pm.addStudent("S" + to_string(i));
+        }
+        assertTrue(!pm.getStudent(1000) && !pm.getStudent(-1), "Unknown student handle is empty");
+
+        // Interleaved appends force rows to relocate inside the shared array
+        for (int round = 0; round < 9; round++) {
+            for (int i = 0; i < 1000; i++) {
+                pm.getStudent(i)->enrolled.push_back(i + round);
+            }
+        }
+        auto s = pm.getStudent(737);
+        assertTrue(s->name == "S737", "Name read from arena");
+        assertTrue(s->enrolled.size() == 9 && s->enrolled[0] == 737 && s->enrolled[8] == 745,
+            "Enrollments survive row relocation");
+        assertTrue(pm.getEnrollmentCount() == 9000, "Enrollment count");
+
+        pm.getStudent(5)->enrolled.clear();
+        pm.compact();
+        assertTrue(pm.getEnrollmentCount() == 8991 && pm.getStudent(6)->enrolled.contains(14),
+            "Compaction keeps live rows");
+        assertTrue(pm.enrollments().rowBegin(1) == pm.enrollments().rowEnd(0), "Compacted rows are contiguous");
+    }
+
+    void testRelationProperties() {
+        cout << "\n--- Testing Relation Properties ---\n";
+
+        Relations rel;
+        rel.ensureSize(3);
+        rel.addPrereq(0, 1);
+        rel.addPrereq(1, 2);
+
+        auto props = rel.properties();
+        auto t = props.transitive();
+        assertTrue(!t && t.x == 0 && t.y == 1 && t.z == 2, "Transitivity witness (0,1),(1,2) without (0,2)");
+        auto r = props.reflexive();
+        assertTrue(!r && r.x == 0, "Reflexivity witness");
+        auto sym = props.symmetric();
+        assertTrue(!sym && sym.x == 0 && sym.y == 1, "Symmetry witness");
+        assertTrue((bool)props.antiSymmetric(), "Chain is antisymmetric");
+
+        rel.addPrereq(2, 1);
+        auto a = rel.properties().antiSymmetric();
+        assertTrue(!a && a.x == 1 && a.y == 2, "Antisymmetry witness");
+
+        // 10k elements: equivalence with 100 blocks and divisibility order
+        const int n = 10000;
+        vector<vector<bool>> blocks(n, vector<bool>(n, false));
+        vector<vector<bool>> divides(n, vector<bool>(n, false));
+        for (int i = 0; i < n; i++) {
+            for (int j = i - i % 100; j < i - i % 100 + 100; j++) blocks[i][j] = true;
+            for (int j = i; j < n; j += i + 1) divides[i][j] = true;
+        }
+
+        auto start = clock();
+        bool equivalence = RelationProperties(blocks).isEquivalence();
+        bool partialOrder = RelationProperties(divides).isPartialOrder();
+        long long ms = (clock() - start) * 1000 / CLOCKS_PER_SEC;
+        cout << "10k-element equivalence + partial order checks: " << ms << " ms\n";
+
+        assertTrue(equivalence, "Block relation is an equivalence");
+        assertTrue(partialOrder, "Divisibility is a partial order");
+
+        blocks[150][250] = true;
+        auto broken = RelationProperties(blocks).transitive();
+        assertTrue(!broken && blocks[broken.x][broken.y] && blocks[broken.y][broken.z] && !blocks[broken.x][broken.z],
+            "Witness is a real transitivity violation");
+    }
+
+    void testModelStore() {
+        cout << "\n--- Testing Model Snapshots ---\n";
+
+        ModelStore store;
+        store.update([](UniversityModel& m) { m.cm.addCourse("CS101", "Programming", 3); return true; });
+        ModelStore::Snapshot before = store.snapshot();
+
+        assertTrue(!store.update([](UniversityModel& m) { m.pm.addStudent("X"); return false; }),
+            "Rejected edit is not published");
+        assertTrue(store.version() == 1 && store.snapshot()->pm.getStudentCount() == 0,
+            "Version unchanged after rejected edit");
+
+        // Every version holds one enrolled student per write, so a reader that
+        // ever sees a torn model would find the counts out of step
+        const int writes = 300;
+        bool consistent = true;
+        bool monotonic = true;
+        vector<thread> readers;
+        mutex resultLock;
+        for (int r = 0; r < 4; r++) {
+            readers.push_back(thread([&]() {
+                unsigned long long last = 0;
+                bool ok = true, ordered = true;
+                while (last < writes + 1) {
+                    ModelStore::Snapshot snap = store.snapshot();
+                    int students = snap->pm.getStudentCount();
+                    if (students != (int)snap->version - 1 || snap->pm.getEnrollmentCount() != students) ok = false;
+                    if (snap->version < last) ordered = false;
+                    last = snap->version;
+                }
+                lock_guard<mutex> lock(resultLock);
+                consistent = consistent && ok;
+                monotonic = monotonic && ordered;
+            }));
+        }
+        for (int i = 0; i < writes; i++) {
+            store.update([i](UniversityModel& m) {
+                int id = m.pm.addStudent("S" + to_string(i));
+                m.pm.getStudent(id)->enrolled.push_back(0);
+                return true;
+            });
+        }
+        for (auto& t : readers) t.join();
+
+        assertTrue(consistent, "Concurrent readers only see whole versions");
+        assertTrue(monotonic, "Readers never see an older version after a newer one");
+        assertTrue(store.version() == writes + 1, "Every serialized write is published");
+        assertTrue(before->version == 1 && before->pm.getStudentCount() == 0 && before->cm.count() == 1,
+            "Held snapshot is unaffected by later writes");
+    }
+
+    void testRequestServer() {
+        cout << "\n--- Testing Request Server ---\n";
+
+        ModelStore store;
+        RequestServer server(store, 4);
+
+        auto replies = server.process({
+            "addCourse CS101 Programming 3",
+            "addCourse CS102 DataStructures 4",
+            "addStudent Ali",
+            "addPrereq 0 1",
+            "stats",
+            "enroll 0 1",
+            "enroll 0 1",
+            "addPrereq 0 9",
+            "proof 1",
+            "proof 1 0",
+            "frobnicate",
+            "enroll x"
+            });
+
+        assertTrue(replies.size() == 12 && replies[0] == "OK 0" && replies[1] == "OK 1" && replies[2] == "OK 0",
+            "Writes reply with new IDs");
+        assertTrue(replies[4] == "OK version=1 courses=2 students=1 faculty=0 rooms=0 prereqs=1 enrollments=0",
+            "Consecutive writes publish one version before the read");
+        assertTrue(replies[5] == "OK" && replies[6] == "ERR already enrolled" && replies[7] == "ERR invalid course IDs",
+            "Writes in one batch are validated in order");
+        assertTrue(replies[8].find("OK not proved") != string::npos && replies[9].find("OK proved") != string::npos,
+            "Proof runs against the snapshot");
+        assertTrue(replies[10] == "ERR unknown command: frobnicate" && replies[11].find("ERR usage: enroll") == 0,
+            "Bad commands get an error reply");
+        assertTrue(store.version() == 2, "Second write batch published once");
+
+        // Many reads in one batch are spread over the pool but answered in order
+        vector<string> lines;
+        for (int i = 0; i < 2000; i++) {
+            lines.push_back(i % 100 == 0 ? "addStudent S" + to_string(i) : "stats");
+        }
+        replies = server.process(lines);
+        bool ordered = true;
+        for (int i = 0; i < 2000; i++) {
+            int students = 1 + i / 100 + 1;
+            if (i % 100 != 0 && replies[i].find("students=" + to_string(students) + " ") == string::npos) ordered = false;
+        }
+        assertTrue(ordered, "Reads see every write queued before them");
+
+        stringstream in("stats\n\ncheck\r\nlatency\n"), out;
+        assertTrue(server.serveStream(in, out) == 3, "Stream mode skips blank lines");
+        assertTrue(out.str().find("OK version=22") != string::npos && out.str().find("latency stats n=") != string::npos,
+            "Stream replies and latency report");
+        assertTrue(server.getLatency(RequestServer::CMD_STATS).count() == 1982, "Latency recorded per command");
+
+        // Batch replies are the only output: nothing from check reaches cout
+        ModelStore checkStore;
+        RequestServer checkServer(checkStore, 2);
+        stringstream script("addCourse CS101 P 3\naddCourse CS102 Q 3\naddStudent A\nenroll 0 0\nenroll 0 1\ncheck\n");
+        stringstream checkReplies, stray;
+        streambuf* saved = cout.rdbuf(stray.rdbuf());
+        checkServer.serveStream(script, checkReplies);
+        cout.rdbuf(saved);
+        bool protocolOnly = true;
+        string line;
+        while (getline(checkReplies, line)) {
+            if (line.compare(0, 2, "OK") != 0 && line.compare(0, 6, "error ") != 0
+                && line.compare(0, 8, "warning ") != 0) protocolOnly = false;
+        }
+        assertTrue(protocolOnly && stray.str().empty(), "Check replies only with error/warning/OK lines");
+    }
+
+    void testDataExporter() {
+        cout << "\n--- Testing Data Export ---\n";
+
+        ModelStore store;
+        store.update([](UniversityModel& m) {
+            m.cm.addCourse("CS101", "Programming, \"Intro\"", 3);
+            m.cm.addCourse("CS102", "DataStructures", 4);
+            m.rel.ensureSize(2);
+            m.rel.addPrereq(0, 1);
+            for (int i = 0; i < 5; i++) {
+                int id = m.pm.addStudent("S" + to_string(i));
+                if (i < 2) m.pm.getStudent(id)->enrolled.push_back(i);
+            }
+            m.pm.addFaculty("Dr. Noor");
+            m.pm.addRoom("R101", 50);
+            m.courseToFaculty.insert(1, 0);
+            return true;
+        });
+
+        DataExporter exporter(store.snapshot(), 2, 64);
+        const auto& tables = exporter.getTables();
+        assertEqual((int)tables.size(), 8, "Every entity and relation has a table");
+
+        stringstream csv, jsonl, arrow;
+        auto stats = exporter.writeTable(tables[0], DataExporter::FORMAT_CSV, csv);
+        assertTrue(stats.ok && csv.str() == "id,code,name,credits\n0,CS101,\"Programming, \"\"Intro\"\"\",3\n1,CS102,DataStructures,4\n",
+            "CSV quotes fields with commas and quotes");
+        assertTrue(stats.bytes == csv.str().size(), "Byte count matches output");
+
+        exporter.writeTable(tables[1], DataExporter::FORMAT_JSONL, jsonl);
+        assertTrue(jsonl.str().find("{\"id\":1,\"name\":\"S1\",\"enrolled\":[1],\"completed\":[]}\n") != string::npos,
+            "JSON Lines row with list columns");
+
+        stats = exporter.writeTable(tables[1], DataExporter::FORMAT_ARROW, arrow);
+        string bytes = arrow.str();
+        assertTrue(stats.ok && stats.batches == 3, "Arrow rows split into record batches");
+        assertTrue(bytes.size() % 8 == 0 && bytes.compare(0, 4, "\xff\xff\xff\xff") == 0
+            && bytes.compare(bytes.size() - 8, 8, string("\xff\xff\xff\xff\0\0\0\0", 8)) == 0,
+            "Arrow stream framed and terminated");
+        assertTrue(bytes.find("S0S1") != string::npos && bytes.find("S4") != string::npos,
+            "Student names written per batch");
+
+        stringstream edges;
+        exporter.writeTable(tables[4], DataExporter::FORMAT_CSV, edges);
+        assertTrue(edges.str() == "prerequisite,course\n0,1\n", "Prerequisite edges exported");
+    }
+
     void testRelations() {
         cout << "\n--- Testing Relations ---\n";
 
@@ -1952,6 +4412,13 @@ public:
         testProofGenerator();
         testConsistencyChecker();
         testPerformanceBenchmark();
+        testCustomBitset();
+        testOptimizedRelations();
+        testStudentStore();
+        testRelationProperties();
+        testModelStore();
+        testRequestServer();
+        testDataExporter();
         testRelations();
         testLargeScale();
         testEdgeCases();
@@ -1969,15 +4436,36 @@ public:
     }
 };
 
-int main() {
-    CourseManager cm;
-    PeopleManager pm;
-    Relations rel;
+int main(int argc, char* argv[]) {
+    ModelStore store;
 
-    CustomMap<int, int> courseToFaculty;
-    CustomMap<int, int> courseToRoom;
+    // Scripted use: "--batch" answers commands from stdin, "--serve <path>"
+    // listens on a Unix socket. Latency histograms go to stderr on exit.
+    if (argc > 1) {
+        string mode = argv[1];
+        if (mode != "--batch" && (mode != "--serve" || argc < 3)) {
+            cerr << "Usage: " << argv[0] << " [--batch | --serve <socket path>]\n";
+            return 1;
+        }
+
+        ios::sync_with_stdio(false);
+        RequestServer server(store);
+        bool ok = true;
+        if (mode == "--batch") {
+            auto start = chrono::steady_clock::now();
+            long long served = server.serveStream(cin, cout);
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            cerr << "Served " << served << " commands in " << fixed << setprecision(3) << seconds
+                << " s (" << (long long)(served / max(seconds, 1e-9)) << " ops/s)\n";
+        }
+        else {
+            ok = server.serveSocket(argv[2]);
+        }
+        cerr << server.latencyReport();
+        return ok ? 0 : 1;
+    }
 
-    CLIInterface cli(cm, pm, rel, courseToFaculty, courseToRoom);
+    CLIInterface cli(store);
 
     cout << string(60, '=') << "\n";
     cout << "  FAST UNIVERSITY MANAGEMENT SYSTEM - NO STDLIB VERSION\n";
@@ -2027,6 +4515,14 @@ int main() {
             break;
         }
 
+        // Read-only view for this command; edits go through store.update
+        ModelStore::Snapshot model = store.snapshot();
+        const CourseManager& cm = model->cm;
+        const PeopleManager& pm = model->pm;
+        const Relations& rel = model->rel;
+        const CustomMap<int, int>& courseToFaculty = model->courseToFaculty;
+        const CustomMap<int, int>& courseToRoom = model->courseToRoom;
+
         switch (choice) {
         case 1: {
             string code, name;
@@ -2038,8 +4534,11 @@ int main() {
             cout << "Credits: ";
             cin >> credits;
 
-            cm.addCourse(code, name, credits);
-            rel.ensureSize(cm.count());
+            store.update([&](UniversityModel& m) {
+                m.cm.addCourse(code, name, credits);
+                m.rel.ensureSize(m.cm.count());
+                return true;
+            });
             DisplayHelper::printSuccess("Course added successfully");
             break;
         }
@@ -2048,7 +4547,7 @@ int main() {
             string name;
             cout << "Student name: ";
             cin >> name;
-            pm.addStudent(name);
+            store.update([&](UniversityModel& m) { m.pm.addStudent(name); return true; });
             DisplayHelper::printSuccess("Student added successfully");
             break;
         }
@@ -2057,7 +4556,7 @@ int main() {
             string name;
             cout << "Faculty name: ";
             cin >> name;
-            pm.addFaculty(name);
+            store.update([&](UniversityModel& m) { m.pm.addFaculty(name); return true; });
             DisplayHelper::printSuccess("Faculty added successfully");
             break;
         }
@@ -2069,7 +4568,7 @@ int main() {
             cin >> name;
             cout << "Capacity: ";
             cin >> capacity;
-            pm.addRoom(name, capacity);
+            store.update([&](UniversityModel& m) { m.pm.addRoom(name, capacity); return true; });
             DisplayHelper::printSuccess("Room added successfully");
             break;
         }
@@ -2081,8 +4580,12 @@ int main() {
             cout << "Dependent course ID: ";
             cin >> b;
 
-            if (a >= 0 && a < cm.count() && b >= 0 && b < cm.count()) {
-                rel.addPrereq(a, b);
+            bool added = store.update([&](UniversityModel& m) {
+                if (a < 0 || a >= m.cm.count() || b < 0 || b >= m.cm.count()) return false;
+                m.rel.addPrereq(a, b);
+                return true;
+            });
+            if (added) {
                 DisplayHelper::printSuccess("Prerequisite added");
             }
             else {
@@ -2098,10 +4601,14 @@ int main() {
             cout << "Faculty ID: ";
             cin >> f;
 
-            if (c >= 0 && c < cm.count() && f >= 0 && f < pm.getFacultyCount()) {
-                courseToFaculty.insert(c, f);
-                auto* fac = pm.getFaculty(f);
+            bool assigned = store.update([&](UniversityModel& m) {
+                if (c < 0 || c >= m.cm.count() || f < 0 || f >= m.pm.getFacultyCount()) return false;
+                m.courseToFaculty.insert(c, f);
+                auto* fac = m.pm.getFaculty(f);
                 if (fac) fac->courses.push_back(c);
+                return true;
+            });
+            if (assigned) {
                 DisplayHelper::printSuccess("Faculty assigned");
             }
             else {
@@ -2117,8 +4624,12 @@ int main() {
             cout << "Room ID: ";
             cin >> r;
 
-            if (c >= 0 && c < cm.count() && r >= 0 && r < pm.getRoomCount()) {
-                courseToRoom.insert(c, r);
+            bool assigned = store.update([&](UniversityModel& m) {
+                if (c < 0 || c >= m.cm.count() || r < 0 || r >= m.pm.getRoomCount()) return false;
+                m.courseToRoom.insert(c, r);
+                return true;
+            });
+            if (assigned) {
                 DisplayHelper::printSuccess("Room assigned");
             }
             else {
@@ -2134,9 +4645,13 @@ int main() {
             cout << "Course ID: ";
             cin >> c;
 
-            auto* student = pm.getStudent(s);
-            if (student && c >= 0 && c < cm.count()) {
+            bool enrolled = store.update([&](UniversityModel& m) {
+                auto student = m.pm.getStudent(s);
+                if (!student || c < 0 || c >= m.cm.count()) return false;
                 student->enrolled.push_back(c);
+                return true;
+            });
+            if (enrolled) {
                 DisplayHelper::printSuccess("Student enrolled");
             }
             else {
@@ -2298,7 +4813,9 @@ int main() {
 
         case 12: {
             ConsistencyChecker checker(cm, pm, rel, courseToFaculty, courseToRoom);
+            DisplayHelper::printInfo("Checking course overlaps using set intersections...");
             checker.runAllChecks();
+            for (const auto& note : checker.getNotes()) DisplayHelper::printInfo(note);
             checker.checkScheduleConflicts();
             checker.displayReport();
             break;
@@ -2323,10 +4840,12 @@ int main() {
                 cli.displayStatistics();
             }
             else if (sub == 2) {
-                string filename;
-                cout << "Enter filename: ";
-                cin >> filename;
-                cli.exportData(filename);
+                string base, format;
+                cout << "Enter base filename: ";
+                cin >> base;
+                cout << "Format (csv/jsonl/arrow/all): ";
+                cin >> format;
+                cli.exportData(base, format);
             }
             break;
         }
@@ -2391,8 +4910,6 @@ int main() {
             cout << "\nAssign Faculty->Room mappings first:\n";
             cout << "Enter mappings (-1 to stop):\n";
 
-            CustomMap<int, int>& facultyToRoom = cli.getFacultyToRoom();
-
             int fid, rid;
             while (true) {
                 cout << "Faculty ID: ";
@@ -2401,9 +4918,13 @@ int main() {
                 cout << "Room ID: ";
                 cin >> rid;
 
-                if (fid >= 0 && fid < pm.getFacultyCount() &&
-                    rid >= 0 && rid < pm.getRoomCount()) {
-                    facultyToRoom.insert(fid, rid);
+                bool mapped = store.update([&](UniversityModel& m) {
+                    if (fid < 0 || fid >= m.pm.getFacultyCount() ||
+                        rid < 0 || rid >= m.pm.getRoomCount()) return false;
+                    m.facultyToRoom.insert(fid, rid);
+                    return true;
+                });
+                if (mapped) {
                     DisplayHelper::printSuccess("Mapping added");
                 }
                 else {
@@ -2411,7 +4932,8 @@ int main() {
                 }
             }
 
-            Functions::analyzeFacultyRooms(facultyToRoom, pm);
+            ModelStore::Snapshot latest = store.snapshot();
+            Functions::analyzeFacultyRooms(latest->facultyToRoom, latest->pm);
             break;
         }
 
@@ -2526,13 +5048,27 @@ int main() {
                 }
             }
             else if (sub == 3) {
+                auto props = rel.properties();
+                auto reflexive = props.reflexive();
+                auto symmetric = props.symmetric();
+                auto transitive = props.transitive();
+                auto antiSymmetric = props.antiSymmetric();
+
                 cout << "\nChecking Relation Properties:\n\n";
-                cout << "Reflexive: " << (rel.isReflexive() ? "[YES]" : "[NO]") << "\n";
-                cout << "Symmetric: " << (rel.isSymmetric() ? "[YES]" : "[NO]") << "\n";
-                cout << "Transitive: " << (rel.isTransitive() ? "[YES]" : "[NO]") << "\n";
-                cout << "Anti-Symmetric: " << (rel.isAntiSymmetric() ? "[YES]" : "[NO]") << "\n\n";
-                cout << "Equivalence Relation: " << (rel.isEquivalenceRelation() ? "[YES]" : "[NO]") << "\n";
-                cout << "Partial Order: " << (rel.isPartialOrder() ? "[YES]" : "[NO]") << "\n";
+                cout << "Reflexive: " << (reflexive ? "[YES]" : "[NO]");
+                if (!reflexive) cout << "  (" << reflexive.x << "," << reflexive.x << ") missing";
+                cout << "\nSymmetric: " << (symmetric ? "[YES]" : "[NO]");
+                if (!symmetric) cout << "  (" << symmetric.x << "," << symmetric.y << ") without ("
+                    << symmetric.y << "," << symmetric.x << ")";
+                cout << "\nTransitive: " << (transitive ? "[YES]" : "[NO]");
+                if (!transitive) cout << "  (" << transitive.x << "," << transitive.y << "), ("
+                    << transitive.y << "," << transitive.z << ") without (" << transitive.x << "," << transitive.z << ")";
+                cout << "\nAnti-Symmetric: " << (antiSymmetric ? "[YES]" : "[NO]");
+                if (!antiSymmetric) cout << "  (" << antiSymmetric.x << "," << antiSymmetric.y << ") and ("
+                    << antiSymmetric.y << "," << antiSymmetric.x << ")";
+                cout << "\n\n";
+                cout << "Equivalence Relation: " << (reflexive && symmetric && transitive ? "[YES]" : "[NO]") << "\n";
+                cout << "Partial Order: " << (reflexive && antiSymmetric && transitive ? "[YES]" : "[NO]") << "\n";
             }
             break;
         }
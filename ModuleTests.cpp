@@ -0,0 +1,593 @@
+// Unit tests for the course modules (CourseManager, RelationsModule,
+// FormulaModule, LogicEngine). A standalone program, built from the same
+// sources as Project1 minus its main.cpp:
+//   g++ -std=c++17 -pthread ModuleTests.cpp CourseManger.cpp FormulaModule.cpp
+//       InductionModule.cpp LogicEngine.cpp PeopleManager.cpp
+//       RelationsModule.cpp ReportWriter.cpp SetOperations.cpp
+#include "CourseManager.h"
+#include "RelationsModule.h"
+#include "FormulaModule.h"
+#include "InductionModule.h"
+#include "LogicEngine.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <functional>
+#include <algorithm>
+
+class ModuleTesting {
+private:
+    int passed;
+    int failed;
+
+    // Keeps the modules' [SUCCESS] chatter out of the test report
+    class Quiet {
+    private:
+        std::ostringstream sink;
+        std::streambuf* saved;
+    public:
+        Quiet() : saved(std::cout.rdbuf(sink.rdbuf())) {}
+        ~Quiet() { std::cout.rdbuf(saved); }
+    };
+
+public:
+    ModuleTesting();
+    void assertTrue(bool condition, const std::string& testName);
+    void testFormulaParser();
+    void testFormulaSolver();
+    void testFormulaBruteForce();
+    void testRequirementCatalogue();
+    void testDisjointSet();
+    void testEquivalentCourses();
+    void testForwardChaining();
+    void testBatchEvaluation();
+    bool runAllTests();
+};
+
+ModuleTesting::ModuleTesting() : passed(0), failed(0) {}
+
+void ModuleTesting::assertTrue(bool condition, const std::string& testName) {
+    if (condition) {
+        std::cout << "  [PASS] " << testName << "\n";
+        passed++;
+    }
+    else {
+        std::cout << "  [FAIL] " << testName << "\n";
+        failed++;
+    }
+}
+
+namespace {
+    // CS101=0, MATH101=1, MATH102=2, CS201=3, CS301=4
+    void addCatalogueCourses(CourseManager& cm) {
+        cm.addCourse("CS101", "Programming Fundamentals", 3);
+        cm.addCourse("MATH101", "Calculus I", 3);
+        cm.addCourse("MATH102", "Calculus II", 3);
+        cm.addCourse("CS201", "Algorithms", 4);
+        cm.addCourse("CS301", "Compilers", 4);
+    }
+
+    // Random degree rules over courses 0..courses-1, cycles included; named
+    // marks the courses some rule mentions, and added collects the rules
+    void addRandomRules(LogicEngine& engine, std::mt19937& rng, int courses, int count, std::vector<bool>& named,
+        std::vector<LogicEngine::Rule>* added = nullptr) {
+        named.assign(courses, false);
+        for (int r = 0; r < count; r++) {
+            std::vector<int> ante, cons;
+            int width = (int)(rng() % 4);
+            for (int i = 0; i < width; i++) ante.push_back((int)(rng() % courses));
+            cons.push_back((int)(rng() % courses));
+            if (rng() % 3 == 0) cons.push_back((int)(rng() % courses));
+            for (int c : ante) named[c] = true;
+            for (int c : cons) named[c] = true;
+            engine.addRule("R" + std::to_string(r), ante, cons, "rule " + std::to_string(r));
+            if (added) added->push_back({ "R" + std::to_string(r), ante, cons, "rule " + std::to_string(r) });
+        }
+    }
+
+    std::vector<std::vector<int>> randomStudents(std::mt19937& rng, int students, int courses, int perStudent) {
+        std::vector<std::vector<int>> completed(students);
+        for (auto& list : completed)
+            for (int i = 0; i < perStudent; i++) list.push_back((int)(rng() % courses));
+        return completed;
+    }
+
+    // Students whose batch row differs from deriveCourses() on one of the
+    // courses the rules name
+    int batchMismatches(const LogicEngine& engine, const LogicEngine::FactMatrix& facts,
+        const std::vector<std::vector<int>>& completed, const std::vector<bool>& named, int step) {
+        int bad = 0;
+        for (int s = 0; s < (int)completed.size(); s += step) {
+            std::vector<bool> expect(named.size(), false);
+            for (int c : completed[s]) expect[c] = true;
+            for (int c : engine.deriveCourses(completed[s])) expect[c] = true;
+            for (int c = 0; c < (int)named.size(); c++) {
+                if (named[c] && engine.holds(facts, s, c) != expect[c]) {
+                    bad++;
+                    break;
+                }
+            }
+        }
+        return bad;
+    }
+
+    // Every rule over every pass until a pass adds nothing
+    std::vector<bool> naiveFixpoint(const std::vector<LogicEngine::Rule>& rules, int courses, const std::vector<int>& completed) {
+        std::vector<bool> known(courses, false);
+        for (int c : completed) known[c] = true;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (const auto& rule : rules) {
+                bool fires = true;
+                for (int a : rule.antecedent) fires = fires && known[a];
+                if (!fires) continue;
+                for (int c : rule.consequent) {
+                    if (!known[c]) changed = known[c] = true;
+                }
+            }
+        }
+        return known;
+    }
+
+    std::vector<bool> completedOf(int n, const std::vector<int>& ids) {
+        std::vector<bool> completed(n, false);
+        for (int id : ids) completed[id] = true;
+        return completed;
+    }
+}
+
+void ModuleTesting::testFormulaParser() {
+    std::cout << "Testing Formula Parser:\n";
+    CourseManager cm;
+    {
+        Quiet quiet;
+        addCatalogueCourses(cm);
+    }
+    Requirements req;
+    BddManager::Ref f, g;
+    std::string error;
+
+    assertTrue(!req.parse("CS101 AND XX999", cm, f, error) && error == "Unknown course code: XX999",
+        "Unknown course code rejected");
+    assertTrue(!req.parse("CS101 AND (MATH101 OR MATH102", cm, f, error) && error == "Missing ')'",
+        "Missing ')' rejected");
+    assertTrue(!req.parse("CS101 MATH101", cm, f, error) && error == "Unexpected 'MATH101'",
+        "Trailing token rejected");
+    assertTrue(!req.parse("CS101 AND", cm, f, error) && error == "Unexpected end of expression",
+        "Dangling operator rejected");
+    assertTrue(!req.parse("CS101 $ MATH101", cm, f, error) && error.find("Unexpected character '$'") == 0,
+        "Bad character rejected");
+
+    bool ok = req.parse("CS101 AND (MATH101 OR MATH102)", cm, f, error)
+        && req.parse("CS101 && (MATH101 || MATH102)", cm, g, error) && f == g
+        && req.parse("cs101 and (math101 or math102)", cm, g, error) == false
+        && req.parse("(MATH102 | MATH101) & CS101", cm, g, error) && f == g;
+    assertTrue(ok, "AND/OR spellings compile to one diagram");
+
+    ok = req.parse("NOT CS101", cm, f, error) && req.parse("!CS101", cm, g, error) && f == g
+        && req.parse("not not CS101", cm, g, error) && g == req.manager().variable(0);
+    assertTrue(ok, "NOT spellings and double negation");
+
+    ok = req.parse("CS101 OR MATH101 AND MATH102", cm, f, error)
+        && req.parse("CS101 OR (MATH101 AND MATH102)", cm, g, error) && f == g;
+    assertTrue(ok, "AND binds tighter than OR");
+
+    ok = req.parse("CS101 OR NOT CS101", cm, f, error) && f == BddManager::TRUE_REF
+        && req.parse("CS101 AND !CS101", cm, g, error) && g == BddManager::FALSE_REF;
+    assertTrue(ok, "Tautology and contradiction reduce to constants");
+    std::cout << "\n";
+}
+
+void ModuleTesting::testFormulaSolver() {
+    std::cout << "Testing Formula Evaluation and Minimal Missing Sets:\n";
+    CourseManager cm;
+    {
+        Quiet quiet;
+        addCatalogueCourses(cm);
+    }
+    Requirements req;
+    BddManager& bdd = req.manager();
+    BddManager::Ref f;
+    std::string error;
+    req.parse("CS101 AND (MATH101 OR MATH102)", cm, f, error);
+
+    assertTrue(!bdd.evaluate(f, completedOf(5, {})) && !bdd.evaluate(f, completedOf(5, { 0 }))
+        && bdd.evaluate(f, completedOf(5, { 0, 2 })) && bdd.evaluate(f, completedOf(5, { 0, 1, 2 }))
+        && !bdd.evaluate(f, completedOf(5, { 1, 2 })), "evaluate over completed sets");
+    assertTrue(bdd.evaluate(f, completedOf(1, { 0 })) == false && bdd.support(f) == std::vector<int>({ 0, 1, 2 }),
+        "Short completed vector and support");
+
+    std::vector<int> missing;
+    assertTrue(bdd.minimalMissing(f, completedOf(5, { 2 }), missing) && missing == std::vector<int>({ 0 }),
+        "Minimal missing set reuses a completed alternative");
+    assertTrue(bdd.minimalMissing(f, completedOf(5, {}), missing) && missing.size() == 2 && missing[0] == 0,
+        "Minimal missing set from scratch");
+    assertTrue(bdd.minimalMissing(f, completedOf(5, { 0, 1 }), missing) && missing.empty(),
+        "Nothing missing once satisfied");
+
+    BddManager::Ref never;
+    req.parse("MATH101 AND NOT MATH101", cm, never, error);
+    assertTrue(!bdd.minimalMissing(never, completedOf(5, {}), missing), "Contradiction is unsatisfiable");
+
+    BddManager::Ref notDone;
+    req.parse("NOT CS101 AND MATH101", cm, notDone, error);
+    assertTrue(bdd.minimalMissing(notDone, completedOf(5, {}), missing) && missing == std::vector<int>({ 1 }),
+        "NOT on a course not taken costs nothing");
+    assertTrue(!bdd.minimalMissing(notDone, completedOf(5, { 0 }), missing),
+        "NOT on a completed course cannot be met");
+    std::cout << "\n";
+}
+
+// Random formulas over 7 courses, each checked against its truth table:
+// evaluate() on every completed set, and minimalMissing() against the
+// cheapest satisfying superset found by enumeration
+void ModuleTesting::testFormulaBruteForce() {
+    std::cout << "Testing Formulas Against Brute Force:\n";
+    const int VARS = 7, MASKS = 1 << VARS;
+    CourseManager cm;
+    {
+        Quiet quiet;
+        for (int v = 0; v < VARS; v++) cm.addCourse("F" + std::to_string(v), "Formula " + std::to_string(v), 3);
+    }
+
+    std::mt19937 rng(2024);
+    const char* andOps[] = { " AND ", " and ", " && ", " & " };
+    const char* orOps[] = { " OR ", " or ", " || ", " | " };
+    const char* notOps[] = { "NOT ", "!", "not " };
+    std::function<std::string(int, std::vector<bool>&)> gen = [&](int depth, std::vector<bool>& table) {
+        table.assign(MASKS, false);
+        int kind = depth == 0 ? 0 : (int)(rng() % 4);
+        if (kind == 0) {
+            int v = (int)(rng() % VARS);
+            for (int m = 0; m < MASKS; m++) table[m] = (m >> v) & 1;
+            return "F" + std::to_string(v);
+        }
+        std::vector<bool> a, b;
+        std::string left = gen(depth - 1, a);
+        if (kind == 1) {
+            for (int m = 0; m < MASKS; m++) table[m] = !a[m];
+            return std::string(notOps[rng() % 3]) + "(" + left + ")";
+        }
+        std::string right = gen(depth - 1, b);
+        for (int m = 0; m < MASKS; m++) table[m] = kind == 2 ? a[m] && b[m] : a[m] || b[m];
+        return "(" + left + (kind == 2 ? andOps[rng() % 4] : orOps[rng() % 4]) + right + ")";
+    };
+
+    int formulas = 0, parseErrors = 0, evalMismatches = 0, missingMismatches = 0;
+    for (int trial = 0; trial < 150; trial++) {
+        Requirements req;
+        std::vector<bool> table;
+        std::string text = gen(5, table), error;
+        BddManager::Ref f;
+        if (!req.parse(text, cm, f, error)) {
+            parseErrors++;
+            continue;
+        }
+        formulas++;
+        for (int m = 0; m < MASKS; m++) {
+            std::vector<bool> completed(VARS);
+            for (int v = 0; v < VARS; v++) completed[v] = (m >> v) & 1;
+            if (req.manager().evaluate(f, completed) != table[m]) evalMismatches++;
+
+            int best = -1;
+            for (int s = 0; s < MASKS; s++) {
+                if ((s & m) != m || !table[s]) continue;
+                int cost = __builtin_popcount(s & ~m);
+                if (best < 0 || cost < best) best = cost;
+            }
+            std::vector<int> missing;
+            bool found = req.manager().minimalMissing(f, completed, missing);
+            int reached = m;
+            for (int v : missing) reached |= 1 << v;
+            bool fresh = true;
+            for (int v : missing) fresh = fresh && !completed[v];
+            if (found != (best >= 0) || (found && ((int)missing.size() != best || !table[reached] || !fresh)))
+                missingMismatches++;
+        }
+    }
+    assertTrue(parseErrors == 0 && formulas == 150, "150 random formulas parse");
+    assertTrue(evalMismatches == 0, "evaluate matches the truth table on every completed set");
+    assertTrue(missingMismatches == 0, "minimalMissing matches brute-force enumeration");
+    std::cout << "\n";
+}
+
+void ModuleTesting::testRequirementCatalogue() {
+    std::cout << "Testing Requirement Catalogue:\n";
+    CourseManager cm;
+    Relations rel;
+    std::vector<std::string> errors;
+    std::istringstream catalogue(
+        "# CS201 needs programming and one calculus course\n"
+        "require CS201: CS101 AND (MATH101 OR MATH102)\n"
+        "\n"
+        "prereq CS201 CS301\n"
+        "require CS999: CS101\n"
+        "require CS301 CS201\n"
+        "prereq CS101\n"
+        "require MATH102: MATH101 OR\n"
+        "retire CS101\n");
+    int applied;
+    {
+        Quiet quiet;
+        addCatalogueCourses(cm);
+        applied = rel.loadCatalogue(catalogue, cm, errors);
+    }
+    assertTrue(applied == 2 && rel.hasRequirement(3) && !rel.hasRequirement(4) && rel.getPrereq(3, 4),
+        "Catalogue directives applied");
+    assertTrue(errors.size() == 5 && errors[0] == "line 5: Unknown course code: CS999"
+        && errors[1] == "line 6: Expected: require CODE: EXPRESSION" && errors[2] == "line 7: Expected: prereq CODE CODE"
+        && errors[3] == "line 8: Unexpected end of expression" && errors[4] == "line 9: Unknown directive: retire",
+        "Bad catalogue lines reported by number");
+
+    std::vector<bool> none(5, false);
+    assertTrue(!rel.isEligible(3, completedOf(5, { 0 })) && rel.isEligible(3, completedOf(5, { 0, 2 }))
+        && !rel.isEligible(4, completedOf(5, { 0, 2 })) && rel.isEligible(4, completedOf(5, { 3 })),
+        "Eligibility follows the compiled requirement");
+
+    Induction induction(rel);
+    assertTrue(induction.checkRecursive(3, completedOf(5, { 0, 1 })) && !induction.checkStrong(3, completedOf(5, { 1, 2 })),
+        "Induction checks use the requirement");
+
+    Relations::MissingPrereqs why = rel.explainMissing(4, completedOf(5, { 2 }));
+    assertTrue(!why.eligible && why.satisfiable && why.missing == std::vector<int>({ 0, 3 })
+        && why.frontier == std::vector<int>({ 0 }) && why.path == std::vector<int>({ 0, 3, 4 }),
+        "explainMissing takes the cheapest branch of a formula");
+    why = rel.explainMissing(4, none);
+    assertTrue(why.missing.size() == 3 && why.missing[0] == 0 && why.missing[2] == 3 && why.frontier.size() == 2
+        && why.path.size() == 3 && why.path.back() == 4, "explainMissing from scratch");
+
+    std::string error;
+    assertTrue(rel.applyDirective("require CS301: CS201 AND NOT MATH101", cm, error), "Requirement replaced");
+    why = rel.explainMissing(4, completedOf(5, { 0, 1 }));
+    assertTrue(!why.eligible && !why.satisfiable, "explainMissing flags an unsatisfiable requirement");
+    std::cout << "\n";
+}
+
+void ModuleTesting::testDisjointSet() {
+    std::cout << "Testing Disjoint Sets:\n";
+    DisjointSet sets(6);
+    bool merged = sets.unite(0, 1) && sets.unite(2, 3) && sets.unite(1, 3);
+    assertTrue(merged && !sets.unite(3, 0) && sets.setCount() == 3 && sets.same(0, 2) && !sets.same(0, 4)
+        && sets.setSize(2) == 4, "unite merges classes once");
+    assertTrue(sets.labels() == std::vector<int>({ 0, 0, 0, 0, 1, 2 }), "labels numbered by first member");
+    assertTrue(sets.classes() == std::vector<std::vector<int>>({ { 0, 1, 2, 3 }, { 4 }, { 5 } }), "classes");
+
+    std::vector<int> members = sets.membersOf(2);
+    std::vector<int> sorted = members;
+    std::sort(sorted.begin(), sorted.end());
+    assertTrue(members.front() == 2 && sorted == std::vector<int>({ 0, 1, 2, 3 })
+        && sets.membersOf(5) == std::vector<int>({ 5 }), "membersOf walks the class ring");
+
+    sets.grow(8);
+    assertTrue(sets.size() == 8 && sets.setCount() == 5 && sets.labels() == std::vector<int>({ 0, 0, 0, 0, 1, 2, 3, 4 }),
+        "grow adds singletons after unions");
+    assertTrue(sets.unite(7, 0) && sets.same(7, 3) && sets.setSize(7) == 5 && sets.membersOf(7).size() == 5
+        && sets.classes().size() == 4, "Grown elements unite with old classes");
+
+    std::vector<std::pair<int, int>> pairs = { { 0, 4 }, { 1, 2 }, { 4, 7 }, { -1, 0 } };
+    assertTrue(DisjointSet::classesOf(5, pairs) == std::vector<int>({ 0, 1, 1, 2, 0 }), "classesOf pairs ignores out-of-range pairs");
+    std::vector<std::vector<bool>> relation(4, std::vector<bool>(4, false));
+    relation[0][2] = true;
+    relation[3][1] = true;
+    assertTrue(DisjointSet::classesOf(relation) == std::vector<int>({ 0, 1, 0, 1 }), "classesOf relation matrix");
+
+    const int N = 1000000;
+    DisjointSet chain(N);
+    for (int i = 0; i + 1 < N; i++) chain.unite(i + 1, i);
+    assertTrue(chain.setCount() == 1 && chain.find(N - 1) == chain.root(0) && chain.setSize(12345) == N
+        && (int)chain.membersOf(N / 2).size() == N, "Million-element chain");
+    std::cout << "\n";
+}
+
+void ModuleTesting::testEquivalentCourses() {
+    std::cout << "Testing Equivalent and Cross-Listed Courses:\n";
+    // CS101=0, CS105=1, CS310=2, MATH310=3, CS400=4, MATH200=5
+    CourseManager cm;
+    Relations rel;
+    std::vector<std::string> errors;
+    std::istringstream catalogue(
+        "equivalent CS101 CS105\n"
+        "crosslist CS310 MATH310\n"
+        "equivalent MATH310 MATH200\n"
+        "prereq CS105 CS400\n"
+        "prereq MATH310 CS400\n"
+        "crosslist CS310\n");
+    int applied;
+    {
+        Quiet quiet;
+        const char* codes[] = { "CS101", "CS105", "CS310", "MATH310", "CS400", "MATH200" };
+        for (const char* code : codes) cm.addCourse(code, code, 3);
+        applied = rel.loadCatalogue(catalogue, cm, errors);
+    }
+    assertTrue(applied == 5 && errors.size() == 1 && errors[0] == "line 6: Expected: crosslist CODE CODE",
+        "Equivalence directives loaded");
+    assertTrue(rel.areEquivalent(0, 1) && rel.areCrossListed(2, 3) && !rel.areCrossListed(2, 5)
+        && rel.areEquivalent(2, 5) && !rel.areEquivalent(0, 2), "Cross-listing is an equivalence");
+    assertTrue(rel.equivalentCourses(2) == std::vector<int>({ 3, 5 }) && rel.crossListingsOf(3) == std::vector<int>({ 2 })
+        && rel.crossListingsOf(4).empty() && rel.equivalentCourses(-1).empty(), "Equivalent and cross-listed lookups");
+    assertTrue(rel.equivalenceClasses() == std::vector<std::vector<int>>({ { 0, 1 }, { 2, 3, 5 }, { 4 } }),
+        "Equivalence classes");
+
+    assertTrue(rel.satisfiedCourses(completedOf(6, { 0, 5 })) == std::vector<bool>({ true, true, true, true, false, true }),
+        "satisfiedCourses widens through equivalents");
+    assertTrue(rel.satisfiedCourses(completedOf(1, { 0 })) == std::vector<bool>({ true, true, false, false, false, false }),
+        "satisfiedCourses pads a short completed vector");
+
+    rel.addImplication(0, 4);
+    rel.addImplication(4, 2);
+    assertTrue(rel.implicationClasses() == std::vector<int>({ 0, 1, 0, 2, 0, 3 }), "Implication classes");
+
+    std::ostringstream out;
+    std::streambuf* saved = std::cout.rdbuf(out.rdbuf());
+    Induction(rel).displayCheck(cm, 4, completedOf(6, { 0, 5 }));
+    std::cout.rdbuf(saved);
+    std::string text = out.str();
+    assertTrue(text.find("STRONG INDUCTION: [PASS]") != std::string::npos
+        && text.find("CS105 [DONE VIA EQUIVALENT]") != std::string::npos
+        && text.find("MATH310 [DONE VIA EQUIVALENT]") != std::string::npos, "displayCheck credits equivalents");
+    std::cout << "\n";
+}
+
+void ModuleTesting::testForwardChaining() {
+    std::cout << "Testing Forward Chaining:\n";
+    LogicEngine engine;
+    {
+        Quiet quiet;
+        engine.addRule("Pair", { 0, 1, 1 }, { 2 }, "0 and 1 give 2");
+        engine.addRule("Next", { 2 }, { 3 }, "2 gives 3");
+        engine.addRule("Side", { 5 }, { 6 }, "5 gives 6");
+    }
+    engine.addFact("course_0");
+    assertTrue(engine.inferConsequences().empty() && !engine.isTrue("course_2"), "Rule waits for every antecedent");
+    engine.addFact("course_1");
+    std::vector<std::string> inferred = engine.inferConsequences();
+    assertTrue(inferred.size() == 2 && engine.isTrue("course_2") && engine.isTrue("course_3"),
+        "Counting propagation chains to the fixpoint");
+    assertTrue(engine.inferConsequences().empty(), "Nothing reported twice");
+    engine.addFact("course_5");
+    inferred = engine.inferConsequences();
+    assertTrue(inferred.size() == 1 && inferred[0] == "Inferred: 5 gives 6", "Incremental fact fires only its rules");
+
+    engine.addFact("course_1", false);
+    inferred = engine.inferConsequences();
+    assertTrue(!engine.isTrue("course_1") && !engine.isTrue("course_2") && !engine.isTrue("course_3")
+        && engine.isTrue("course_0") && engine.isTrue("course_6"), "Retraction withdraws what it supported");
+    assertTrue(inferred.empty(), "Facts that still follow are not reported again");
+    engine.addFact("course_1");
+    assertTrue(engine.inferConsequences().size() == 2 && engine.isTrue("course_3"), "Re-asserting derives again");
+
+    std::vector<int> derived = engine.deriveCourses({ 5, 0, 1 });
+    std::sort(derived.begin(), derived.end());
+    assertTrue(derived == std::vector<int>({ 2, 3, 6 }) && engine.deriveCourses({ 1 }).empty(),
+        "deriveCourses from a completed list");
+    assertTrue(engine.isTrue("course_3") && engine.isTrue("course_5"), "deriveCourses leaves the engine's facts alone");
+
+    std::mt19937 rng(43);
+    LogicEngine randomEngine;
+    std::vector<bool> named;
+    std::vector<LogicEngine::Rule> rules;
+    {
+        Quiet quiet;
+        addRandomRules(randomEngine, rng, 80, 300, named, &rules);
+    }
+    std::vector<std::vector<int>> students = randomStudents(rng, 500, 80, 4);
+    int deriveMismatches = 0, incrementalMismatches = 0;
+    for (int s = 0; s < (int)students.size(); s++) {
+        std::vector<bool> expect = naiveFixpoint(rules, 80, students[s]);
+        std::vector<bool> got(80, false);
+        for (int c : students[s]) got[c] = true;
+        for (int c : randomEngine.deriveCourses(students[s])) got[c] = true;
+        if (got != expect) deriveMismatches++;
+
+        if (s % 10) continue;
+        LogicEngine incremental;
+        {
+            Quiet quiet;
+            for (const auto& rule : rules) incremental.addRule(rule.name, rule.antecedent, rule.consequent, rule.description);
+        }
+        for (int c : students[s]) {
+            incremental.addFact("course_" + std::to_string(c));
+            incremental.inferConsequences();
+        }
+        for (int c = 0; c < 80; c++) {
+            if (named[c] && incremental.isTrue("course_" + std::to_string(c)) != expect[c]) {
+                incrementalMismatches++;
+                break;
+            }
+        }
+    }
+    assertTrue(deriveMismatches == 0, "deriveCourses matches a naive fixpoint on 500 students");
+    assertTrue(incrementalMismatches == 0, "Fact-at-a-time inference matches a naive fixpoint");
+    std::cout << "\n";
+}
+
+void ModuleTesting::testBatchEvaluation() {
+    std::cout << "Testing Batch Rule Evaluation:\n";
+    {
+        // 0 -> 1 -> 2 -> 0 is a cycle; 3 AND 1 -> 4 depends on it
+        LogicEngine engine;
+        std::vector<bool> named(5, true);
+        {
+            Quiet quiet;
+            engine.addRule("A", { 0 }, { 1 }, "0 gives 1");
+            engine.addRule("B", { 1 }, { 2 }, "1 gives 2");
+            engine.addRule("C", { 2 }, { 0 }, "2 gives 0");
+            engine.addRule("D", { 3, 1 }, { 4 }, "3 and 1 give 4");
+        }
+        std::vector<std::vector<int>> completed = { {}, { 0 }, { 2 }, { 3 }, { 3, 1 }, { 2, 3 } };
+        LogicEngine::FactMatrix facts = engine.loadStudents(completed);
+        bool ok = engine.evaluateAll(facts, 1);
+        assertTrue(ok && batchMismatches(engine, facts, completed, named, 1) == 0 && engine.holds(facts, 5, 4)
+            && !engine.holds(facts, 3, 4) && engine.studentsWith(facts, 0) == std::vector<int>({ 1, 2, 4, 5 }),
+            "Cyclic rule base reaches the fixpoint");
+    }
+    {
+        // An empty antecedent fires for every student, and only for them
+        LogicEngine engine;
+        {
+            Quiet quiet;
+            engine.addRule("Free", {}, { 7 }, "everyone gets 7");
+            engine.addRule("Chain", { 7 }, { 8 }, "7 gives 8");
+        }
+        LogicEngine::FactMatrix facts = engine.loadStudents(std::vector<std::vector<int>>(130));
+        bool ok = engine.evaluateAll(facts, 1);
+        std::vector<int> with = engine.studentsWith(facts, 8);
+        assertTrue(ok && facts.count(engine.atomCount() - 1) == 130 && with.size() == 130 && with.back() == 129,
+            "Tail word masks students past the end");
+    }
+    {
+        std::mt19937 rng(44);
+        LogicEngine engine;
+        std::vector<bool> named;
+        {
+            Quiet quiet;
+            addRandomRules(engine, rng, 80, 300, named);
+        }
+        std::vector<std::vector<int>> completed = randomStudents(rng, 10000, 80, 4);
+        LogicEngine::FactMatrix serial = engine.loadStudents(completed);
+        LogicEngine::FactMatrix parallel = engine.loadStudents(completed);
+        bool ok = engine.evaluateAll(serial, 1) && engine.evaluateAll(parallel, 4);
+        bool same = true;
+        for (int c = 0; c < 80; c++) same = same && engine.studentsWith(serial, c) == engine.studentsWith(parallel, c);
+        assertTrue(ok && same, "Four threads match one thread");
+        assertTrue(batchMismatches(engine, parallel, completed, named, 7) == 0,
+            "Batch results match deriveCourses on sampled students");
+
+        {
+            Quiet quiet;
+            engine.addRule("Late", { 0 }, { 80 }, "names a new course");
+        }
+        LogicEngine::FactMatrix stale = engine.loadStudents(completed);
+        ok = !engine.evaluateAll(serial, 1);
+        assertTrue(ok && engine.evaluateAll(stale, 2) && engine.holds(stale, 0, 80) == engine.holds(stale, 0, 0),
+            "Matrix loaded before new rules is refused");
+    }
+    std::cout << "\n";
+}
+
+bool ModuleTesting::runAllTests() {
+    passed = 0;
+    failed = 0;
+    std::cout << "\n" << std::string(60, '=') << "\n MODULE TESTS\n" << std::string(60, '=') << "\n\n";
+
+    testFormulaParser();
+    testFormulaSolver();
+    testFormulaBruteForce();
+    testRequirementCatalogue();
+    testDisjointSet();
+    testEquivalentCourses();
+    testForwardChaining();
+    testBatchEvaluation();
+
+    std::cout << std::string(60, '=') << "\n";
+    std::cout << "Passed: " << passed << "  Failed: " << failed << "  Total: " << (passed + failed) << "\n";
+    return failed == 0;
+}
+
+int main() {
+    ModuleTesting tests;
+    return tests.runAllTests() ? 0 : 1;
+}
@@ -1,4 +1,5 @@
 #include "PeopleManager.h"
+#include "ReportWriter.h"
 #include <iostream>
 #include <iomanip>
 
@@ -61,44 +62,39 @@ int PeopleManager::getRoomCount() const {
     return static_cast<int>(rooms.size());
 }
 
-void PeopleManager::listAllStudents() const {
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << " ALL STUDENTS\n";
-    std::cout << std::string(60, '=') << "\n\n";
-    std::cout << std::left << std::setw(5) << "ID" << std::setw(30) << "Name"
-        << "Enrolled\n";
-    std::cout << std::string(60, '-') << "\n";
+void PeopleManager::listAllStudents(int firstRow, int maxRows) const {
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text(" ALL STUDENTS").newline().repeat('=', 60).newline().newline();
+    w.left("ID", 5).left("Name", 30).text("Enrolled").newline();
+    w.repeat('-', 60).newline();
+    int row = 0, shown = 0;
     for (const auto& s : students) {
-        std::cout << std::left << std::setw(5) << s.id << std::setw(30) << s.name
-            << s.enrolled.size() << " courses\n";
+        if (row++ < firstRow || (maxRows >= 0 && shown >= maxRows)) continue;
+        shown++;
+        w.left(s.id, 5).left(s.name, 30).number((long long)s.enrolled.size()).text(" courses").newline();
     }
-    std::cout << "\nTotal Students: " << students.size() << "\n";
+    w.showing(firstRow, shown, row);
+    w.newline().text("Total Students: ").number((long long)students.size()).newline();
 }
 
 void PeopleManager::listAllFaculties() const {
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << " ALL FACULTY\n";
-    std::cout << std::string(60, '=') << "\n\n";
-    std::cout << std::left << std::setw(5) << "ID" << std::setw(30) << "Name"
-        << "Courses\n";
-    std::cout << std::string(60, '-') << "\n";
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text(" ALL FACULTY").newline().repeat('=', 60).newline().newline();
+    w.left("ID", 5).left("Name", 30).text("Courses").newline();
+    w.repeat('-', 60).newline();
     for (const auto& f : faculties) {
-        std::cout << std::left << std::setw(5) << f.id << std::setw(30) << f.name
-            << f.courses.size() << " courses\n";
+        w.left(f.id, 5).left(f.name, 30).number((long long)f.courses.size()).text(" courses").newline();
     }
-    std::cout << "\nTotal Faculty: " << faculties.size() << "\n";
+    w.newline().text("Total Faculty: ").number((long long)faculties.size()).newline();
 }
 
 void PeopleManager::listAllRooms() const {
-    std::cout << "\n" << std::string(60, '=') << "\n";
-    std::cout << " ALL ROOMS\n";
-    std::cout << std::string(60, '=') << "\n\n";
-    std::cout << std::left << std::setw(5) << "ID" << std::setw(20) << "Room"
-        << "Capacity\n";
-    std::cout << std::string(60, '-') << "\n";
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text(" ALL ROOMS").newline().repeat('=', 60).newline().newline();
+    w.left("ID", 5).left("Room", 20).text("Capacity").newline();
+    w.repeat('-', 60).newline();
     for (const auto& r : rooms) {
-        std::cout << std::left << std::setw(5) << r.id << std::setw(20) << r.roomNumber
-            << r.capacity << "\n";
+        w.left(r.id, 5).left(r.roomNumber, 20).number(r.capacity).newline();
     }
-    std::cout << "\nTotal Rooms: " << rooms.size() << "\n";
+    w.newline().text("Total Rooms: ").number((long long)rooms.size()).newline();
 }
\ No newline at end of file
@@ -53,7 +53,8 @@ public:
     int getFacultyCount() const;
     int getRoomCount() const;
 
-    void listAllStudents() const;
+    // Rows firstRow.. (maxRows < 0: to the end)
+    void listAllStudents(int firstRow = 0, int maxRows = -1) const;
     void listAllFaculties() const;
     void listAllRooms() const;
 };
@@ -1,26 +1,99 @@
 #include "RelationsModule.h"
 #include "CourseManager.h"
+#include "ReportWriter.h"
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <algorithm>
 
 Relations::Relations() : size(0) {}
 
 void Relations::ensureSize(int n) {
     if (n > size) {
+        for (auto& row : prereq) row.resize(n, false);
         prereq.resize(n, std::vector<bool>(n, false));
-        implication.resize(n, std::vector<bool>(n, false));
+        implies.resize(n);
+        directPrereqs.resize(n);
+        equivalent.grow(n);
+        crossListed.grow(n);
         size = n;
     }
 }
 
 void Relations::addPrereq(int a, int b) {
     ensureSize(std::max(a, b) + 1);
+    if (!prereq[a][b]) directPrereqs[b].push_back(a);
     prereq[a][b] = true;
 }
 
 void Relations::addImplication(int a, int b) {
     ensureSize(std::max(a, b) + 1);
-    implication[a][b] = true;
+    if (!getImplication(a, b)) implies[a].push_back(b);
+}
+
+bool Relations::getImplication(int a, int b) const {
+    if (a < 0 || b < 0 || a >= size || b >= size) return false;
+    return std::find(implies[a].begin(), implies[a].end(), b) != implies[a].end();
+}
+
+void Relations::addEquivalence(int a, int b) {
+    if (a < 0 || b < 0) return;
+    ensureSize(std::max(a, b) + 1);
+    equivalent.unite(a, b);
+}
+
+void Relations::addCrossListing(int a, int b) {
+    if (a < 0 || b < 0) return;
+    ensureSize(std::max(a, b) + 1);
+    crossListed.unite(a, b);
+    equivalent.unite(a, b);
+}
+
+bool Relations::areEquivalent(int a, int b) const {
+    if (a < 0 || b < 0 || a >= size || b >= size) return a == b;
+    return equivalent.same(a, b);
+}
+
+bool Relations::areCrossListed(int a, int b) const {
+    if (a < 0 || b < 0 || a >= size || b >= size) return a == b;
+    return crossListed.same(a, b);
+}
+
+namespace {
+    std::vector<int> membersOf(const DisjointSet& sets, int x) {
+        std::vector<int> result;
+        if (x < 0 || x >= sets.size()) return result;
+        result = sets.membersOf(x);
+        result.erase(result.begin());
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+std::vector<int> Relations::equivalentCourses(int courseId) const { return membersOf(equivalent, courseId); }
+
+std::vector<int> Relations::crossListingsOf(int courseId) const { return membersOf(crossListed, courseId); }
+
+std::vector<std::vector<int>> Relations::equivalenceClasses() const { return equivalent.classes(); }
+
+std::vector<int> Relations::implicationClasses() const {
+    std::vector<std::pair<int, int>> pairs;
+    for (int a = 0; a < size; a++)
+        for (int b : implies[a]) pairs.push_back(std::make_pair(a, b));
+    return DisjointSet::classesOf(size, pairs);
+}
+
+std::vector<bool> Relations::satisfiedCourses(const std::vector<bool>& completed) const {
+    std::vector<bool> classDone(equivalent.setCount(), false);
+    std::vector<int> label = equivalent.labels();
+    for (int i = 0; i < (int)completed.size() && i < size; i++)
+        if (completed[i]) classDone[label[i]] = true;
+
+    std::vector<bool> result = completed;
+    if ((int)result.size() < size) result.resize(size, false);
+    for (int i = 0; i < size; i++)
+        if (classDone[label[i]]) result[i] = true;
+    return result;
 }
 
 bool Relations::getPrereq(int a, int b) const {
@@ -28,6 +101,154 @@ bool Relations::getPrereq(int a, int b) const {
     return prereq[a][b];
 }
 
+const std::vector<int>& Relations::prerequisitesOf(int courseId) const {
+    static const std::vector<int> none;
+    if (courseId < 0 || courseId >= size) return none;
+    return directPrereqs[courseId];
+}
+
+bool Relations::setRequirement(int courseId, const std::string& expr, const CourseManager& cm, std::string& error) {
+    if (courseId < 0) {
+        error = "Invalid course ID";
+        return false;
+    }
+    if (!formulas.setRequirement(courseId, expr, cm, error)) return false;
+    // Courses named in the formula are walked by explainMissing
+    int needed = courseId + 1;
+    for (int v : formulas.manager().support(formulas.requirementOf(courseId))) needed = std::max(needed, v + 1);
+    ensureSize(needed);
+    return true;
+}
+
+bool Relations::hasRequirement(int courseId) const { return formulas.hasRequirement(courseId); }
+
+const Requirements& Relations::getRequirements() const { return formulas; }
+
+namespace {
+    bool isDirective(const std::string& line) {
+        size_t start = line.find_first_not_of(" \t\r");
+        return start != std::string::npos && line[start] != '#';
+    }
+
+    bool lookupCode(const CourseManager& cm, const std::string& code, int& id, std::string& error) {
+        id = cm.getCourseByCode(code);
+        if (id < 0) error = "Unknown course code: " + code;
+        return id >= 0;
+    }
+}
+
+bool Relations::applyDirective(const std::string& line, const CourseManager& cm, std::string& error) {
+    if (!isDirective(line)) return true;
+    std::istringstream in(line);
+    std::string keyword;
+    in >> keyword;
+
+    if (keyword == "require") {
+        std::string rest;
+        std::getline(in, rest);
+        size_t colon = rest.find(':');
+        std::istringstream head(rest.substr(0, colon));
+        std::string code, extra;
+        if (colon == std::string::npos || !(head >> code) || (head >> extra)) {
+            error = "Expected: require CODE: EXPRESSION";
+            return false;
+        }
+        int id;
+        if (!lookupCode(cm, code, id, error)) return false;
+        return setRequirement(id, rest.substr(colon + 1), cm, error);
+    }
+    if (keyword == "prereq" || keyword == "equivalent" || keyword == "crosslist") {
+        std::string first, second, extra;
+        if (!(in >> first >> second) || (in >> extra)) {
+            error = "Expected: " + keyword + " CODE CODE";
+            return false;
+        }
+        int a, b;
+        if (!lookupCode(cm, first, a, error) || !lookupCode(cm, second, b, error)) return false;
+        if (keyword == "prereq") addPrereq(a, b);
+        else if (keyword == "equivalent") addEquivalence(a, b);
+        else addCrossListing(a, b);
+        return true;
+    }
+    error = "Unknown directive: " + keyword;
+    return false;
+}
+
+int Relations::loadCatalogue(std::istream& in, const CourseManager& cm, std::vector<std::string>& errors) {
+    int applied = 0, lineNo = 0;
+    std::string line, error;
+    while (std::getline(in, line)) {
+        lineNo++;
+        if (!isDirective(line)) continue;
+        if (applyDirective(line, cm, error)) applied++;
+        else errors.push_back("line " + std::to_string(lineNo) + ": " + error);
+    }
+    return applied;
+}
+
+bool Relations::isEligible(int courseId, const std::vector<bool>& satisfied) const {
+    if (formulas.hasRequirement(courseId)) return formulas.isEligible(courseId, satisfied);
+    for (int p : prerequisitesOf(courseId)) {
+        if (p >= (int)satisfied.size() || !satisfied[p]) return false;
+    }
+    return true;
+}
+
+// Courses that must still be taken before courseId opens: the cheapest way
+// to satisfy its compiled requirement, or its unsatisfied direct
+// prerequisites. False if the requirement cannot be met at all.
+bool Relations::unmetFor(int courseId, const std::vector<bool>& satisfied, std::vector<int>& unmet) const {
+    unmet.clear();
+    if (formulas.hasRequirement(courseId)) return formulas.minimalMissing(courseId, satisfied, unmet);
+    for (int p : directPrereqs[courseId]) {
+        if (p >= (int)satisfied.size() || !satisfied[p]) unmet.push_back(p);
+    }
+    return true;
+}
+
+// Breadth-first backwards from the target through unsatisfied courses only,
+// since a satisfied course's own prerequisites no longer matter. A course
+// with a compiled requirement contributes its minimal missing set. Every
+// course and edge is visited at most once, and BFS order makes the first
+// frontier course found the nearest one.
+Relations::MissingPrereqs Relations::explainMissing(int target, const std::vector<bool>& satisfied) const {
+    MissingPrereqs result;
+    result.eligible = true;
+    result.satisfiable = true;
+    if (target < 0 || target >= size) return result;
+
+    // -2 unseen, -1 the target, otherwise the course one step closer to it
+    std::vector<int> next(size, -2);
+    std::vector<int> queue(1, target), unmet;
+    next[target] = -1;
+    int nearest = -1;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int x = queue[head];
+        if (!unmetFor(x, satisfied, unmet)) result.satisfiable = false;
+        bool open = unmet.empty() && isEligible(x, satisfied);
+        for (int p : unmet) {
+            if (next[p] == -2) {
+                next[p] = x;
+                queue.push_back(p);
+            }
+        }
+        if (x == target) {
+            result.eligible = open;
+            continue;
+        }
+        result.missing.push_back(x);
+        if (open) {
+            result.frontier.push_back(x);
+            if (nearest < 0) nearest = x;
+        }
+    }
+
+    for (int c = nearest; c >= 0; c = next[c]) result.path.push_back(c);
+    std::sort(result.missing.begin(), result.missing.end());
+    std::sort(result.frontier.begin(), result.frontier.end());
+    return result;
+}
+
 int Relations::getSize() const { return size; }
 
 std::vector<std::vector<bool>> Relations::closurePrereq() const {
@@ -72,22 +293,129 @@ bool Relations::isPartialOrder() const {
 }
 
 void Relations::displayMatrix(const CourseManager& cm) const {
-    std::cout << "\n" << std::string(60, '=') << "\n PREREQUISITE MATRIX\n" << std::string(60, '=') << "\n\n";
-    std::cout << " ";
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text(" PREREQUISITE MATRIX").newline().repeat('=', 60).newline().newline();
+    std::vector<std::string> labels(size);
     for (int i = 0; i < size; i++) {
         const auto* c = cm.getCourse(i);
-        std::cout << std::setw(6) << (c ? c->code : std::to_string(i));
+        labels[i] = c ? c->code : std::to_string(i);
     }
-    std::cout << "\n";
-    for (int i = 0; i < size; i++) {
-        const auto* c = cm.getCourse(i);
-        std::cout << std::setw(5) << (c ? c->code : std::to_string(i));
-        for (int j = 0; j < size; j++) {
-            std::cout << std::setw(6) << (prereq[i][j] ? "Y" : ".");
+    if (size <= DENSE_MATRIX_LIMIT) {
+        w.put(' ');
+        for (int i = 0; i < size; i++) w.right(labels[i], 6);
+        w.newline();
+        for (int i = 0; i < size; i++) {
+            w.right(labels[i], 5);
+            for (int j = 0; j < size; j++) w.right(prereq[i][j] ? "Y" : ".", 6);
+            w.newline();
         }
-        std::cout << "\n";
+        w.newline().text("Y = Has prerequisite | . = No relationship").newline();
+        return;
+    }
+    long long edges = 0;
+    for (int j = 0; j < size; j++) {
+        if (directPrereqs[j].empty()) continue;
+        w.left(labels[j], 12).text(" requires:");
+        for (int i : directPrereqs[j]) w.put(' ').text(labels[i]);
+        w.newline();
+        edges += directPrereqs[j].size();
+    }
+    w.newline().number(size).text(" courses, ").number(edges).text(" prerequisite pairs (sparse view)").newline();
+}
+
+const std::vector<std::vector<bool>>& Relations::getPrereqMatrix() const { return prereq; }
+
+DisjointSet::DisjointSet(int n) : sets(0) { grow(n); }
+
+void DisjointSet::grow(int n) {
+    for (int i = (int)parent.size(); i < n; i++) {
+        parent.push_back(i);
+        rank.push_back(0);
+        members.push_back(1);
+        next.push_back(i);
+        sets++;
     }
-    std::cout << "\nY = Has prerequisite | . = No relationship\n";
 }
 
-const std::vector<std::vector<bool>>& Relations::getPrereqMatrix() const { return prereq; }
\ No newline at end of file
+int DisjointSet::find(int x) {
+    int r = root(x);
+    while (parent[x] != r) {
+        int next = parent[x];
+        parent[x] = r;
+        x = next;
+    }
+    return r;
+}
+
+int DisjointSet::root(int x) const {
+    while (parent[x] != x) x = parent[x];
+    return x;
+}
+
+bool DisjointSet::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return false;
+    if (rank[a] < rank[b]) std::swap(a, b);
+    parent[b] = a;
+    members[a] += members[b];
+    // Swapping successors splices the two rings into one
+    std::swap(next[a], next[b]);
+    if (rank[a] == rank[b]) rank[a]++;
+    sets--;
+    return true;
+}
+
+bool DisjointSet::same(int a, int b) const { return root(a) == root(b); }
+
+int DisjointSet::size() const { return (int)parent.size(); }
+
+int DisjointSet::setCount() const { return sets; }
+
+int DisjointSet::setSize(int x) const { return members[root(x)]; }
+
+std::vector<int> DisjointSet::membersOf(int x) const {
+    std::vector<int> result;
+    result.reserve(setSize(x));
+    int i = x;
+    do {
+        result.push_back(i);
+        i = next[i];
+    } while (i != x);
+    return result;
+}
+
+std::vector<int> DisjointSet::labels() const {
+    std::vector<int> byRoot(parent.size(), -1);
+    std::vector<int> result(parent.size());
+    int next = 0;
+    for (int i = 0; i < (int)parent.size(); i++) {
+        int r = root(i);
+        if (byRoot[r] < 0) byRoot[r] = next++;
+        result[i] = byRoot[r];
+    }
+    return result;
+}
+
+std::vector<std::vector<int>> DisjointSet::classes() const {
+    std::vector<int> label = labels();
+    std::vector<std::vector<int>> result(sets);
+    for (int i = 0; i < (int)label.size(); i++) result[label[i]].push_back(i);
+    return result;
+}
+
+std::vector<int> DisjointSet::classesOf(int n, const std::vector<std::pair<int, int>>& pairs) {
+    DisjointSet sets(n);
+    for (const auto& p : pairs)
+        if (p.first >= 0 && p.first < n && p.second >= 0 && p.second < n) sets.unite(p.first, p.second);
+    return sets.labels();
+}
+
+std::vector<int> DisjointSet::classesOf(const std::vector<std::vector<bool>>& relation) {
+    int n = (int)relation.size();
+    DisjointSet sets(n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < (int)relation[i].size() && j < n; j++)
+            if (relation[i][j]) sets.unite(i, j);
+    return sets.labels();
+}
\ No newline at end of file
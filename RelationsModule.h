@@ -2,20 +2,106 @@
 #define RELATIONSMODULE_H
 
 #include <vector>
+#include <utility>
+#include <string>
+#include <iosfwd>
+#include "FormulaModule.h"
 
 class CourseManager;
 
+// Union-find over 0..n-1: union by rank, path compression in find().
+// Both are iterative, so chains over millions of elements are safe.
+// root() answers without compressing for const callers; rank keeps trees
+// O(log n) deep. Each class is also threaded as a ring through next, so
+// membersOf() costs the size of the class rather than of the universe.
+class DisjointSet {
+private:
+    std::vector<int> parent;
+    std::vector<unsigned char> rank;
+    std::vector<int> members;
+    std::vector<int> next;
+    int sets;
+public:
+    explicit DisjointSet(int n = 0);
+    void grow(int n);
+    int find(int x);
+    int root(int x) const;
+    bool unite(int a, int b);
+    bool same(int a, int b) const;
+    int size() const;
+    int setCount() const;
+    int setSize(int x) const;
+    // x's class in ring order, starting with x
+    std::vector<int> membersOf(int x) const;
+    // Dense class number per element, numbered in order of first member
+    std::vector<int> labels() const;
+    std::vector<std::vector<int>> classes() const;
+    // Classes of the smallest equivalence relation containing the pairs
+    static std::vector<int> classesOf(int n, const std::vector<std::pair<int, int>>& pairs);
+    static std::vector<int> classesOf(const std::vector<std::vector<bool>>& relation);
+};
+
 class Relations {
 private:
     std::vector<std::vector<bool>> prereq;
-    std::vector<std::vector<bool>> implication;
+    std::vector<std::vector<int>> implies;
+    std::vector<std::vector<int>> directPrereqs;
+    DisjointSet equivalent;
+    DisjointSet crossListed;
+    Requirements formulas;
     int size;
+    bool unmetFor(int, const std::vector<bool>&, std::vector<int>& unmet) const;
 public:
+    // Why a course is not yet open to a student. frontier holds the missing
+    // prerequisites that can be taken now; every other missing course waits
+    // on one of them. path is a shortest chain from a frontier course to
+    // the target.
+    struct MissingPrereqs {
+        bool eligible;
+        std::vector<int> missing;
+        std::vector<int> frontier;
+        std::vector<int> path;
+        // false when a compiled requirement on the way cannot be met by
+        // taking more courses
+        bool satisfiable;
+    };
+
     Relations();
     void ensureSize(int);
     void addPrereq(int, int);
     void addImplication(int, int);
+    bool getImplication(int, int) const;
+    // Equivalent courses satisfy the same requirements; a cross-listing is
+    // one course under two codes, so it is an equivalence as well
+    void addEquivalence(int, int);
+    void addCrossListing(int, int);
+    bool areEquivalent(int, int) const;
+    bool areCrossListed(int, int) const;
+    std::vector<int> equivalentCourses(int) const;
+    std::vector<int> crossListingsOf(int) const;
+    std::vector<std::vector<int>> equivalenceClasses() const;
+    std::vector<int> implicationClasses() const;
+    // completed widened to every course equivalent to a completed one
+    std::vector<bool> satisfiedCourses(const std::vector<bool>&) const;
     bool getPrereq(int, int) const;
+    const std::vector<int>& prerequisitesOf(int) const;
+    // A course with a compiled requirement ("CS101 AND (MATH101 OR
+    // MATH102)") is judged by its BDD; other courses need every direct
+    // prerequisite
+    bool setRequirement(int, const std::string&, const CourseManager&, std::string& error);
+    bool hasRequirement(int) const;
+    const Requirements& getRequirements() const;
+    // Catalogue directives, one per line, with course codes as in cm:
+    //   prereq CS101 CS201                         CS101 comes before CS201
+    //   require CS201: CS101 AND (MATH101 OR MATH102)
+    //   equivalent CS101 CS105                     either one satisfies the other
+    //   crosslist CS310 MATH310                    one course under two codes
+    // Blank lines and lines starting with '#' are skipped. loadCatalogue
+    // returns how many directives applied and reports each bad line.
+    bool applyDirective(const std::string&, const CourseManager&, std::string& error);
+    int loadCatalogue(std::istream&, const CourseManager&, std::vector<std::string>& errors);
+    bool isEligible(int, const std::vector<bool>& satisfied) const;
+    MissingPrereqs explainMissing(int, const std::vector<bool>& satisfied) const;
     int getSize() const;
     std::vector<std::vector<bool>> closurePrereq() const;
     bool hasPrereqCycle() const;
@@ -24,6 +110,9 @@ public:
     bool isTransitive() const;
     bool isEquivalence() const;
     bool isPartialOrder() const;
+    // Full grid up to DENSE_MATRIX_LIMIT courses, one line per course with
+    // its direct prerequisites above that
+    static const int DENSE_MATRIX_LIMIT = 40;
     void displayMatrix(const CourseManager&) const;
     const std::vector<std::vector<bool>>& getPrereqMatrix() const;
 };
@@ -0,0 +1,89 @@
+#include "ReportWriter.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+ReportWriter::ReportWriter(std::ostream& o, size_t capacity)
+    : out(o), buffer(std::max(capacity, size_t(256))), used(0) {}
+
+ReportWriter::~ReportWriter() {
+    flush();
+}
+
+// Room for n more bytes; a field larger than the whole buffer grows it
+char* ReportWriter::reserve(size_t n) {
+    if (used + n > buffer.size()) {
+        flush();
+        if (n > buffer.size()) buffer.resize(n);
+    }
+    return buffer.data() + used;
+}
+
+ReportWriter& ReportWriter::text(std::string_view s) {
+    std::memcpy(reserve(s.size()), s.data(), s.size());
+    used += s.size();
+    return *this;
+}
+
+ReportWriter& ReportWriter::put(char c) {
+    *reserve(1) = c;
+    used++;
+    return *this;
+}
+
+ReportWriter& ReportWriter::repeat(char c, int count) {
+    if (count <= 0) return *this;
+    std::memset(reserve(count), c, count);
+    used += count;
+    return *this;
+}
+
+ReportWriter& ReportWriter::number(long long value) {
+    char* p = reserve(24);
+    used = std::to_chars(p, p + 24, value).ptr - buffer.data();
+    return *this;
+}
+
+ReportWriter& ReportWriter::left(std::string_view s, int width) {
+    text(s);
+    return repeat(' ', width - static_cast<int>(s.size()));
+}
+
+ReportWriter& ReportWriter::left(long long value, int width) {
+    char digits[24];
+    char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    return left(std::string_view(digits, end - digits), width);
+}
+
+ReportWriter& ReportWriter::right(std::string_view s, int width) {
+    repeat(' ', width - static_cast<int>(s.size()));
+    return text(s);
+}
+
+ReportWriter& ReportWriter::right(long long value, int width) {
+    char digits[24];
+    char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    return right(std::string_view(digits, end - digits), width);
+}
+
+ReportWriter& ReportWriter::newline() {
+    return put('\n');
+}
+
+ReportWriter& ReportWriter::showing(int firstRow, int shown, int total) {
+    if (shown >= total) return *this;
+    newline().text("Showing ");
+    if (shown == 0) text("0");
+    else {
+        int first = std::max(firstRow, 0) + 1;
+        number(first).put('-').number(first + shown - 1);
+    }
+    return text(" of ").number(total).newline();
+}
+
+void ReportWriter::flush() {
+    if (used == 0) return;
+    out.write(buffer.data(), static_cast<std::streamsize>(used));
+    used = 0;
+    out.flush();
+}
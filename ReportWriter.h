@@ -0,0 +1,42 @@
+#ifndef REPORTWRITER_H
+#define REPORTWRITER_H
+
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+// Buffered text output for large listings. Fields are formatted into one
+// reusable buffer (numbers via to_chars) and reach the stream in a single
+// write per flush, so listings are bound by I/O rather than per-field
+// stream formatting. Fields pad like setw: too-long values are printed
+// whole. A field larger than the buffer grows it. Destruction flushes.
+class ReportWriter {
+private:
+    std::ostream& out;
+    std::vector<char> buffer;
+    size_t used;
+
+    char* reserve(size_t n);
+
+public:
+    explicit ReportWriter(std::ostream& out = std::cout, size_t capacity = 1 << 16);
+    ~ReportWriter();
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    ReportWriter& text(std::string_view s);
+    ReportWriter& put(char c);
+    ReportWriter& repeat(char c, int count);
+    ReportWriter& number(long long value);
+    ReportWriter& left(std::string_view s, int width);
+    ReportWriter& left(long long value, int width);
+    ReportWriter& right(std::string_view s, int width);
+    ReportWriter& right(long long value, int width);
+    ReportWriter& newline();
+    // Paging footer "Showing a-b of N", or "Showing 0 of N" when firstRow
+    // is past the end; nothing when every row was shown
+    ReportWriter& showing(int firstRow, int shown, int total);
+    void flush();
+};
+
+#endif // REPORTWRITER_H
@@ -36,16 +36,43 @@ std::vector<CustomSet<int>> SetOps::powerSet(const CustomSet<int>& S) {
     std::vector<CustomSet<int>> result;
     std::vector<int> elements = S.getVector();
     int n = elements.size();
-    for (int mask = 0; mask < (1 << n); mask++) {
+    // Materializing 2^n sets is only sensible for small n; use the enumerators otherwise
+    if (n > 24) {
+        std::cout << "[ERROR] Power set of " << n << " elements is too large to store!\n";
+        return result;
+    }
+    result.reserve(static_cast<size_t>(1) << n);
+    std::vector<int> members;
+    forEachSubset(n, [&](unsigned long long mask) {
+        maskToElements(mask, elements, members);
         CustomSet<int> subset;
-        for (int i = 0; i < n; i++) {
-            if (mask & (1 << i)) subset.insert(elements[i]);
-        }
+        for (int x : members) subset.insert(x);
         result.push_back(subset);
-    }
+        return true;
+    });
     return result;
 }
 
+int SetOps::maskToIndices(unsigned long long mask, std::vector<int>& out) {
+    out.clear();
+    while (mask) {
+        out.push_back(lowestBit(mask));
+        mask &= mask - 1;
+    }
+    return static_cast<int>(out.size());
+}
+
+int SetOps::maskToElements(unsigned long long mask, const std::vector<int>& elements, std::vector<int>& out) {
+    out.clear();
+    while (mask) {
+        int i = lowestBit(mask);
+        if (i >= static_cast<int>(elements.size())) break;
+        out.push_back(elements[i]);
+        mask &= mask - 1;
+    }
+    return static_cast<int>(out.size());
+}
+
 void SetOps::displaySet(const CustomSet<int>& s, const CourseManager& cm) {
     std::cout << "{ ";
     bool first = true;
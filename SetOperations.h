@@ -3,15 +3,131 @@
 
 #include "CourseManager.h"
 #include "PeopleManager.h"
+#include <vector>
+#include <thread>
+#include <atomic>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 class SetOps {
 public:
+    // Subsets of an n-element sequence are passed as 64-bit masks (bit i =
+    // element i). Visitors return false to stop; the enumerators return the
+    // number of subsets visited and never allocate per subset.
+    static const int MAX_MASK_ELEMENTS = 63;
+
     static CustomSet<int> unionSet(const CustomSet<int>&, const CustomSet<int>&);
     static CustomSet<int> intersection(const CustomSet<int>&, const CustomSet<int>&);
     static CustomSet<int> difference(const CustomSet<int>&, const CustomSet<int>&);
     static CustomSet<int> symmetricDifference(const CustomSet<int>&, const CustomSet<int>&);
     static std::vector<CustomSet<int>> powerSet(const CustomSet<int>&);
+    static int maskToIndices(unsigned long long, std::vector<int>&);
+    static int maskToElements(unsigned long long, const std::vector<int>&, std::vector<int>&);
     static void display(const CourseManager&, int, int, PeopleManager&);
+
+    static int lowestBit(unsigned long long x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#else
+        int index = 0;
+        while (!(x & 1ULL)) {
+            x >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    // Masks first..last inclusive in increasing order
+    template<typename Visitor>
+    static unsigned long long forEachSubset(int n, Visitor visit, unsigned long long first = 0,
+        unsigned long long last = ~0ULL) {
+        if (n < 0 || n > MAX_MASK_ELEMENTS) return 0;
+        unsigned long long full = (1ULL << n) - 1;
+        if (last > full) last = full;
+        unsigned long long visited = 0;
+        for (unsigned long long mask = first; mask <= last; mask++) {
+            visited++;
+            if (!visit(mask) || mask == last) break;
+        }
+        return visited;
+    }
+
+    // Gray-code order: consecutive masks differ in exactly one element, so
+    // visit(mask, bit, added) can update running totals in O(1). The empty
+    // set comes first with bit = -1.
+    template<typename Visitor>
+    static unsigned long long forEachSubsetGray(int n, Visitor visit) {
+        if (n < 0 || n > MAX_MASK_ELEMENTS) return 0;
+        unsigned long long mask = 0, count = 1ULL << n;
+        if (!visit(mask, -1, false)) return 1;
+        for (unsigned long long i = 1; i < count; i++) {
+            int bit = lowestBit(i);
+            mask ^= 1ULL << bit;
+            if (!visit(mask, bit, ((mask >> bit) & 1ULL) != 0)) return i + 1;
+        }
+        return count;
+    }
+
+    // k-element subsets in increasing mask order (Gosper's hack)
+    template<typename Visitor>
+    static unsigned long long forEachKSubset(int n, int k, Visitor visit) {
+        if (n < 0 || n > MAX_MASK_ELEMENTS || k < 0 || k > n) return 0;
+        if (k == 0) {
+            visit(0ULL);
+            return 1;
+        }
+        unsigned long long limit = 1ULL << n, mask = (1ULL << k) - 1, visited = 0;
+        while (mask < limit) {
+            visited++;
+            if (!visit(mask)) break;
+            unsigned long long low = mask & (~mask + 1);
+            unsigned long long ripple = mask + low;
+            mask = (((ripple ^ mask) >> 2) / low) | ripple;
+        }
+        return visited;
+    }
+
+    // Splits the mask space into fixed chunks handed out through an atomic
+    // cursor. visit(mask) runs concurrently and must be thread-safe; any
+    // false return stops all workers after their current chunk.
+    template<typename Visitor>
+    static unsigned long long parallelForEachSubset(int n, Visitor visit, int threads = 0) {
+        if (n < 0 || n > MAX_MASK_ELEMENTS) return 0;
+        const unsigned long long CHUNK = 1ULL << 14;
+        unsigned long long count = 1ULL << n;
+        if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        if (count <= CHUNK) threads = 1;
+
+        std::atomic<unsigned long long> next(0), visited(0);
+        std::atomic<bool> stop(false);
+        auto worker = [&]() {
+            unsigned long long local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                unsigned long long begin = next.fetch_add(CHUNK);
+                if (begin >= count) break;
+                unsigned long long end = std::min(count, begin + CHUNK);
+                for (unsigned long long mask = begin; mask < end; mask++) {
+                    local++;
+                    if (!visit(mask)) {
+                        stop.store(true);
+                        break;
+                    }
+                }
+            }
+            visited += local;
+        };
+        std::vector<std::thread> workers;
+        for (int t = 1; t < threads; t++) workers.push_back(std::thread(worker));
+        worker();
+        for (auto& w : workers) w.join();
+        return visited.load();
+    }
 private:
     static void displaySet(const CustomSet<int>&, const CourseManager&);
 };
@@ -4,9 +4,229 @@
 #include <sstream>
 #include <algorithm>
 #include <chrono>
+#include <climits>
+#include <cctype>
+#include <cstring>
 
 using namespace std;
 
+// ============================================================================
+// COURSE CODE INDEX IMPLEMENTATION
+// ============================================================================
+
+CourseCodeIndex::CourseCodeIndex() : table(16), entries(0), perfect(false), foldedValid(true) {
+    for (auto& s : table) s.courseId = -1;
+}
+
+unsigned long long CourseCodeIndex::pack(const string& code) {
+    unsigned long long word = 0;
+    if (code.size() <= sizeof(word)) memcpy(&word, code.data(), code.size());
+    return word;
+}
+
+unsigned long long CourseCodeIndex::mix(unsigned long long h, unsigned int seed) {
+    // splitmix64 finalizer over the stored hash and the bucket's seed
+    unsigned long long x = h ^ (seed * 0x9E3779B97F4A7C15ULL);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+size_t CourseCodeIndex::reduce(unsigned long long h, size_t n) {
+    // Maps the top 32 hash bits onto [0, n) with a multiply instead of a division
+    return static_cast<size_t>(((h >> 32) * n) >> 32);
+}
+
+bool CourseCodeIndex::matches(const Slot& s, size_t hash, unsigned long long packed, const string& code) {
+    if (s.courseId < 0 || s.hash != hash || s.length != static_cast<int>(code.size())) return false;
+    if (s.length <= 8) return s.packed == packed;
+    return s.code.view() == code;
+}
+
+void CourseCodeIndex::grow() {
+    vector<Slot> old;
+    old.swap(table);
+    table.resize(old.size() * 2);
+    for (auto& s : table) s.courseId = -1;
+    size_t mask = table.size() - 1;
+    for (const auto& s : old) {
+        if (s.courseId < 0) continue;
+        size_t i = s.hash & mask;
+        while (table[i].courseId >= 0) i = (i + 1) & mask;
+        table[i] = s;
+    }
+}
+
+bool CourseCodeIndex::insert(const PooledString& code, int courseId) {
+    string key = code.str();
+    size_t hash = StringPool::hash(key);
+    unsigned long long packed = pack(key);
+    size_t mask = table.size() - 1;
+    size_t i = hash & mask;
+    for (; table[i].courseId >= 0; i = (i + 1) & mask) {
+        if (matches(table[i], hash, packed, key)) return false;
+    }
+    table[i].hash = hash;
+    table[i].packed = packed;
+    table[i].length = static_cast<int>(key.size());
+    table[i].courseId = courseId;
+    table[i].code = code;
+    entries++;
+    if (entries * 2 > static_cast<int>(table.size())) grow();
+
+    // New codes fall back to the probing table until the next finalize()
+    perfect = false;
+    foldedValid = false;
+    return true;
+}
+
+bool CourseCodeIndex::erase(const string& code) {
+    size_t hash = StringPool::hash(code);
+    unsigned long long packed = pack(code);
+    size_t mask = table.size() - 1;
+    size_t i = hash & mask;
+    while (table[i].courseId >= 0 && !matches(table[i], hash, packed, code)) i = (i + 1) & mask;
+    if (table[i].courseId < 0) return false;
+
+    // Backward-shift deletion keeps every probe chain unbroken without tombstones
+    table[i].courseId = -1;
+    for (size_t j = (i + 1) & mask; table[j].courseId >= 0; j = (j + 1) & mask) {
+        size_t home = table[j].hash & mask;
+        bool movable = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+        if (movable) {
+            table[i] = table[j];
+            table[j].courseId = -1;
+            i = j;
+        }
+    }
+    entries--;
+    perfect = false;
+    foldedValid = false;
+    return true;
+}
+
+int CourseCodeIndex::find(const string& code) const {
+    size_t hash = StringPool::hash(code);
+    unsigned long long packed = pack(code);
+    if (perfect) {
+        size_t bucket = reduce(mix(hash, 0), displacement.size());
+        const Slot& s = perfectSlots[reduce(mix(hash, displacement[bucket]), perfectSlots.size())];
+        return matches(s, hash, packed, code) ? s.courseId : -1;
+    }
+    size_t mask = table.size() - 1;
+    for (size_t i = hash & mask; table[i].courseId >= 0; i = (i + 1) & mask) {
+        if (matches(table[i], hash, packed, code)) return table[i].courseId;
+    }
+    return -1;
+}
+
+bool CourseCodeIndex::finalize() {
+    perfect = false;
+    perfectSlots.clear();
+    displacement.clear();
+    if (entries == 0) return false;
+
+    // Hash-and-displace: place the largest buckets first, searching per
+    // bucket for a seed that sends all of its keys to free slots
+    int n = entries;
+    int bucketCount = max(1, n / 4);
+    vector<vector<const Slot*>> buckets(bucketCount);
+    for (const auto& s : table) {
+        if (s.courseId >= 0) buckets[reduce(mix(s.hash, 0), bucketCount)].push_back(&s);
+    }
+    vector<int> order(bucketCount);
+    for (int b = 0; b < bucketCount; b++) order[b] = b;
+    sort(order.begin(), order.end(), [&](int a, int b) { return buckets[a].size() > buckets[b].size(); });
+
+    vector<Slot> slots(n);
+    for (auto& s : slots) s.courseId = -1;
+    vector<unsigned int> seeds(bucketCount, 0);
+    vector<size_t> positions;
+    for (int b : order) {
+        if (buckets[b].empty()) break;
+        bool placed = false;
+        for (unsigned int seed = 1; seed < (1u << 20) && !placed; seed++) {
+            positions.clear();
+            placed = true;
+            for (const Slot* s : buckets[b]) {
+                size_t pos = reduce(mix(s->hash, seed), n);
+                if (slots[pos].courseId >= 0 || find_if(positions.begin(), positions.end(),
+                        [pos](size_t p) { return p == pos; }) != positions.end()) {
+                    placed = false;
+                    break;
+                }
+                positions.push_back(pos);
+            }
+            if (placed) {
+                for (size_t k = 0; k < positions.size(); k++) slots[positions[k]] = *buckets[b][k];
+                seeds[b] = seed;
+            }
+        }
+        if (!placed) return false;
+    }
+
+    perfectSlots.swap(slots);
+    displacement.swap(seeds);
+    perfect = true;
+    return true;
+}
+
+bool CourseCodeIndex::isPerfect() const {
+    return perfect;
+}
+
+int CourseCodeIndex::size() const {
+    return entries;
+}
+
+void CourseCodeIndex::clear() {
+    table.assign(16, Slot());
+    for (auto& s : table) s.courseId = -1;
+    entries = 0;
+    perfect = false;
+    perfectSlots.clear();
+    displacement.clear();
+    folded.clear();
+    foldedValid = true;
+}
+
+string CourseCodeIndex::fold(const string& s) {
+    string out(s);
+    for (auto& ch : out) ch = static_cast<char>(toupper(static_cast<unsigned char>(ch)));
+    return out;
+}
+
+void CourseCodeIndex::buildFolded() const {
+    if (foldedValid) return;
+    folded.clear();
+    folded.reserve(entries);
+    for (const auto& s : table) {
+        if (s.courseId >= 0) folded.push_back(make_pair(fold(s.code.str()), s.courseId));
+    }
+    sort(folded.begin(), folded.end());
+    foldedValid = true;
+}
+
+int CourseCodeIndex::findIgnoreCase(const string& code) const {
+    int exact = find(code);
+    if (exact >= 0) return exact;
+    buildFolded();
+    string key = fold(code);
+    auto it = lower_bound(folded.begin(), folded.end(), make_pair(key, INT_MIN));
+    return (it != folded.end() && it->first == key) ? it->second : -1;
+}
+
+vector<int> CourseCodeIndex::findByPrefix(const string& prefix) const {
+    buildFolded();
+    string key = fold(prefix);
+    vector<int> result;
+    for (auto it = lower_bound(folded.begin(), folded.end(), make_pair(key, INT_MIN));
+         it != folded.end() && it->first.compare(0, key.size(), key) == 0; ++it) {
+        result.push_back(it->second);
+    }
+    return result;
+}
+
 // ============================================================================
 // COURSE MANAGER IMPLEMENTATION
 // ============================================================================
@@ -17,48 +237,107 @@ CourseManager::Course::Course(int i, string c, string n, int cr)
     : id(i), code(c), name(n), credits(cr), active(true) {}
 
 int CourseManager::addCourse(const string& code, const string& name, int credits) {
-    if (codeToId.contains(code)) {
+    if (getCourseByCode(code) >= 0) {
         cout << "[ERROR] Course code already exists!\n";
         return -1;
     }
-    int id = static_cast<int>(courses.size());
-    courses.push_back(Course(id, code, name, credits));
-    codeToId.insert(code, id);
+    int id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        courses[id] = Course(id, code, name, credits);
+    } else {
+        id = static_cast<int>(courses.size());
+        courses.push_back(Course(id, code, name, credits));
+    }
+    codeToId.insert(courses[id].code, id);
     cout << "[SUCCESS] Added course: " << code << "\n";
     return id;
 }
 
+bool CourseManager::removeCourse(int id) {
+    if (!isActive(id)) return false;
+    codeToId.erase(courses[id].code.str());
+    courses[id].active = false;
+    freeIds.push_back(id);
+    return true;
+}
+
+bool CourseManager::isActive(int id) const {
+    return id >= 0 && id < static_cast<int>(courses.size()) && courses[id].active;
+}
+
+int CourseManager::activeCount() const {
+    return static_cast<int>(courses.size() - freeIds.size());
+}
+
+vector<int> CourseManager::compactionMap() const {
+    vector<int> newIds(courses.size(), -1);
+    int next = 0;
+    for (size_t i = 0; i < courses.size(); i++) {
+        if (courses[i].active) newIds[i] = next++;
+    }
+    return newIds;
+}
+
+void CourseManager::compact(const vector<int>& newIds) {
+    vector<Course> kept;
+    kept.reserve(activeCount());
+    codeToId.clear();
+    for (size_t i = 0; i < courses.size(); i++) {
+        if (i >= newIds.size() || newIds[i] < 0) continue;
+        kept.push_back(courses[i]);
+        kept.back().id = newIds[i];
+        codeToId.insert(kept.back().code, newIds[i]);
+    }
+    courses.swap(kept);
+    freeIds.clear();
+}
+
 const CourseManager::Course* CourseManager::getCourse(int id) const {
-    if (id < 0 || id >= static_cast<int>(courses.size())) return nullptr;
+    if (!isActive(id)) return nullptr;
     return &courses[id];
 }
 
 CourseManager::Course* CourseManager::getCourse(int id) {
-    if (id < 0 || id >= static_cast<int>(courses.size())) return nullptr;
+    if (!isActive(id)) return nullptr;
     return &courses[id];
 }
 
 int CourseManager::getCourseByCode(const string& code) const {
-    const int* id = codeToId.get(code);
-    return id ? *id : -1;
+    return codeToId.find(code);
+}
+
+int CourseManager::getCourseByCodeIgnoreCase(const string& code) const {
+    return codeToId.findIgnoreCase(code);
+}
+
+vector<int> CourseManager::findCoursesByPrefix(const string& prefix) const {
+    return codeToId.findByPrefix(prefix);
+}
+
+bool CourseManager::finalizeCodeIndex() {
+    return codeToId.finalize();
 }
 
 int CourseManager::count() const {
     return static_cast<int>(courses.size());
 }
 
-void CourseManager::listAll() const {
-    cout << "\n" << string(60, '=') << "\n";
-    cout << "  ALL COURSES\n";
-    cout << string(60, '=') << "\n\n";
-    cout << left << setw(5) << "ID" << setw(12) << "Code"
-        << setw(25) << "Name" << "Credits\n";
-    cout << string(60, '-') << "\n";
+void CourseManager::listAll(int firstRow, int maxRows) const {
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text("  ALL COURSES").newline().repeat('=', 60).newline().newline();
+    w.left("ID", 5).left("Code", 12).left("Name", 25).text("Credits").newline();
+    w.repeat('-', 60).newline();
+    int row = 0, shown = 0;
     for (const auto& c : courses) {
-        cout << left << setw(5) << c.id << setw(12) << c.code
-            << setw(25) << c.name << c.credits << "\n";
+        if (!c.active) continue;
+        if (row++ < firstRow || (maxRows >= 0 && shown >= maxRows)) continue;
+        shown++;
+        w.left(c.id, 5).left(c.code.view(), 12).left(c.name.view(), 25).number(c.credits).newline();
     }
-    cout << "\nTotal Courses: " << courses.size() << "\n";
+    w.showing(firstRow, shown, row);
+    w.newline().text("Total Courses: ").number(activeCount()).newline();
 }
 
 const vector<CourseManager::Course>& CourseManager::getAllCourses() const {
@@ -69,64 +348,167 @@ const vector<CourseManager::Course>& CourseManager::getAllCourses() const {
 // PEOPLE MANAGER IMPLEMENTATION
 // ============================================================================
 
-PeopleManager::Student::Student() : id(-1) {}
-PeopleManager::Student::Student(int i, string n) : id(i), name(n) {}
+PeopleManager::Student::Student() : id(-1), active(true) {}
+PeopleManager::Student::Student(int i, string n) : id(i), name(n), active(true) {}
 
-PeopleManager::Faculty::Faculty() : id(-1) {}
-PeopleManager::Faculty::Faculty(int i, string n) : id(i), name(n) {}
+PeopleManager::Faculty::Faculty() : id(-1), active(true) {}
+PeopleManager::Faculty::Faculty(int i, string n) : id(i), name(n), active(true) {}
 
-PeopleManager::Room::Room() : id(-1), capacity(0) {}
+PeopleManager::Room::Room() : id(-1), capacity(0), active(true) {}
 PeopleManager::Room::Room(int i, string n, int cap)
-    : id(i), name(n), roomNumber(n), capacity(cap) {}
+    : id(i), name(n), roomNumber(n), capacity(cap), active(true) {}
+
+namespace {
+
+// Shared by the three people tables: reuse a retired slot before appending
+template<typename T>
+int placeRecord(vector<T>& records, vector<int>& freeIds, const T& record) {
+    int id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        records[id] = record;
+    } else {
+        id = static_cast<int>(records.size());
+        records.push_back(record);
+    }
+    records[id].id = id;
+    return id;
+}
+
+template<typename T>
+bool retireRecord(vector<T>& records, vector<int>& freeIds, int id) {
+    if (id < 0 || id >= static_cast<int>(records.size()) || !records[id].active) return false;
+    records[id].active = false;
+    freeIds.push_back(id);
+    return true;
+}
+
+template<typename T>
+vector<int> denseIds(const vector<T>& records) {
+    vector<int> newIds(records.size(), -1);
+    int next = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (records[i].active) newIds[i] = next++;
+    }
+    return newIds;
+}
+
+template<typename T>
+void keepMapped(vector<T>& records, vector<int>& freeIds, const vector<int>& newIds) {
+    vector<T> kept;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (i >= newIds.size() || newIds[i] < 0) continue;
+        kept.push_back(records[i]);
+        kept.back().id = newIds[i];
+    }
+    records.swap(kept);
+    freeIds.clear();
+}
+
+void remapCourseList(vector<int>& list, const vector<int>& courseIds) {
+    size_t out = 0;
+    for (int c : list) {
+        if (c >= 0 && c < static_cast<int>(courseIds.size()) && courseIds[c] >= 0) list[out++] = courseIds[c];
+    }
+    list.resize(out);
+}
+
+} // namespace
 
 int PeopleManager::addStudent(const string& name) {
-    int id = static_cast<int>(students.size());
-    students.push_back(Student(id, name));
+    int id = placeRecord(students, freeStudentIds, Student(-1, name));
     cout << "[SUCCESS] Added student: " << name << "\n";
     return id;
 }
 
 int PeopleManager::addFaculty(const string& name) {
-    int id = static_cast<int>(faculties.size());
-    faculties.push_back(Faculty(id, name));
+    int id = placeRecord(faculties, freeFacultyIds, Faculty(-1, name));
     cout << "[SUCCESS] Added faculty: " << name << "\n";
     return id;
 }
 
 int PeopleManager::addRoom(const string& name, int capacity) {
-    int id = static_cast<int>(rooms.size());
-    rooms.push_back(Room(id, name, capacity));
+    int id = placeRecord(rooms, freeRoomIds, Room(-1, name, capacity));
     cout << "[SUCCESS] Added room: " << name << "\n";
     return id;
 }
 
+bool PeopleManager::removeStudent(int id) {
+    return retireRecord(students, freeStudentIds, id);
+}
+
+bool PeopleManager::removeFaculty(int id) {
+    return retireRecord(faculties, freeFacultyIds, id);
+}
+
+bool PeopleManager::removeRoom(int id) {
+    return retireRecord(rooms, freeRoomIds, id);
+}
+
+int PeopleManager::activeStudentCount() const {
+    return static_cast<int>(students.size() - freeStudentIds.size());
+}
+
+int PeopleManager::activeFacultyCount() const {
+    return static_cast<int>(faculties.size() - freeFacultyIds.size());
+}
+
+int PeopleManager::activeRoomCount() const {
+    return static_cast<int>(rooms.size() - freeRoomIds.size());
+}
+
+vector<int> PeopleManager::studentCompactionMap() const {
+    return denseIds(students);
+}
+
+vector<int> PeopleManager::facultyCompactionMap() const {
+    return denseIds(faculties);
+}
+
+vector<int> PeopleManager::roomCompactionMap() const {
+    return denseIds(rooms);
+}
+
+void PeopleManager::compact(const vector<int>& studentIds, const vector<int>& facultyIds,
+                            const vector<int>& roomIds, const vector<int>& courseIds) {
+    keepMapped(students, freeStudentIds, studentIds);
+    keepMapped(faculties, freeFacultyIds, facultyIds);
+    keepMapped(rooms, freeRoomIds, roomIds);
+    for (auto& s : students) {
+        remapCourseList(s.enrolled, courseIds);
+        remapCourseList(s.completed, courseIds);
+    }
+    for (auto& f : faculties) remapCourseList(f.courses, courseIds);
+}
+
 PeopleManager::Student* PeopleManager::getStudent(int id) {
-    if (id < 0 || id >= static_cast<int>(students.size())) return nullptr;
+    if (id < 0 || id >= static_cast<int>(students.size()) || !students[id].active) return nullptr;
     return &students[id];
 }
 
 PeopleManager::Faculty* PeopleManager::getFaculty(int id) {
-    if (id < 0 || id >= static_cast<int>(faculties.size())) return nullptr;
+    if (id < 0 || id >= static_cast<int>(faculties.size()) || !faculties[id].active) return nullptr;
     return &faculties[id];
 }
 
 PeopleManager::Room* PeopleManager::getRoom(int id) {
-    if (id < 0 || id >= static_cast<int>(rooms.size())) return nullptr;
+    if (id < 0 || id >= static_cast<int>(rooms.size()) || !rooms[id].active) return nullptr;
     return &rooms[id];
 }
 
 const PeopleManager::Student* PeopleManager::getStudent(int id) const {
-    if (id < 0 || id >= static_cast<int>(students.size())) return nullptr;
+    if (id < 0 || id >= static_cast<int>(students.size()) || !students[id].active) return nullptr;
     return &students[id];
 }
 
 const PeopleManager::Faculty* PeopleManager::getFaculty(int id) const {
-    if (id < 0 || id >= static_cast<int>(faculties.size())) return nullptr;
+    if (id < 0 || id >= static_cast<int>(faculties.size()) || !faculties[id].active) return nullptr;
     return &faculties[id];
 }
 
 const PeopleManager::Room* PeopleManager::getRoom(int id) const {
-    if (id < 0 || id >= static_cast<int>(rooms.size())) return nullptr;
+    if (id < 0 || id >= static_cast<int>(rooms.size()) || !rooms[id].active) return nullptr;
     return &rooms[id];
 }
 
@@ -142,43 +524,147 @@ int PeopleManager::getRoomCount() const {
     return static_cast<int>(rooms.size());
 }
 
-void PeopleManager::listAllStudents() const {
-    cout << "\n" << string(60, '=') << "\n";
-    cout << "  ALL STUDENTS\n";
-    cout << string(60, '=') << "\n\n";
-    cout << left << setw(5) << "ID" << setw(30) << "Name" << "Enrolled\n";
-    cout << string(60, '-') << "\n";
+void PeopleManager::listAllStudents(int firstRow, int maxRows) const {
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text("  ALL STUDENTS").newline().repeat('=', 60).newline().newline();
+    w.left("ID", 5).left("Name", 30).text("Enrolled").newline();
+    w.repeat('-', 60).newline();
+    int row = 0, shown = 0;
     for (const auto& s : students) {
-        cout << left << setw(5) << s.id << setw(30) << s.name
-            << s.enrolled.size() << " courses\n";
+        if (!s.active) continue;
+        if (row++ < firstRow || (maxRows >= 0 && shown >= maxRows)) continue;
+        shown++;
+        w.left(s.id, 5).left(s.name.view(), 30).number((long long)s.enrolled.size()).text(" courses").newline();
     }
-    cout << "\nTotal Students: " << students.size() << "\n";
+    w.showing(firstRow, shown, row);
+    w.newline().text("Total Students: ").number(activeStudentCount()).newline();
 }
 
 void PeopleManager::listAllFaculties() const {
-    cout << "\n" << string(60, '=') << "\n";
-    cout << "  ALL FACULTY\n";
-    cout << string(60, '=') << "\n\n";
-    cout << left << setw(5) << "ID" << setw(30) << "Name" << "Courses\n";
-    cout << string(60, '-') << "\n";
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text("  ALL FACULTY").newline().repeat('=', 60).newline().newline();
+    w.left("ID", 5).left("Name", 30).text("Courses").newline();
+    w.repeat('-', 60).newline();
     for (const auto& f : faculties) {
-        cout << left << setw(5) << f.id << setw(30) << f.name
-            << f.courses.size() << " courses\n";
+        if (!f.active) continue;
+        w.left(f.id, 5).left(f.name.view(), 30).number((long long)f.courses.size()).text(" courses").newline();
     }
-    cout << "\nTotal Faculty: " << faculties.size() << "\n";
+    w.newline().text("Total Faculty: ").number(activeFacultyCount()).newline();
 }
 
 void PeopleManager::listAllRooms() const {
-    cout << "\n" << string(60, '=') << "\n";
-    cout << "  ALL ROOMS\n";
-    cout << string(60, '=') << "\n\n";
-    cout << left << setw(5) << "ID" << setw(20) << "Room" << "Capacity\n";
-    cout << string(60, '-') << "\n";
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text("  ALL ROOMS").newline().repeat('=', 60).newline().newline();
+    w.left("ID", 5).left("Room", 20).text("Capacity").newline();
+    w.repeat('-', 60).newline();
     for (const auto& r : rooms) {
-        cout << left << setw(5) << r.id << setw(20) << r.roomNumber
-            << r.capacity << "\n";
+        if (!r.active) continue;
+        w.left(r.id, 5).left(r.roomNumber.view(), 20).number(r.capacity).newline();
+    }
+    w.newline().text("Total Rooms: ").number(activeRoomCount()).newline();
+}
+
+// ============================================================================
+// ENTITY LIFECYCLE IMPLEMENTATION
+// ============================================================================
+
+LifecycleManager::LifecycleManager(CourseManager& c, PeopleManager& p, Relations& r,
+                                   CustomMap<int, int>& cf, CustomMap<int, int>& cr)
+    : cm(c), pm(p), rel(r), courseToFaculty(cf), courseToRoom(cr) {}
+
+void LifecycleManager::eraseValue(vector<int>& list, int value) {
+    list.erase(remove(list.begin(), list.end(), value), list.end());
+}
+
+void LifecycleManager::eraseByValue(CustomMap<int, int>& map, int value) {
+    vector<int> keys;
+    for (const auto& pair : map) {
+        if (pair.second == value) keys.push_back(pair.first);
     }
-    cout << "\nTotal Rooms: " << rooms.size() << "\n";
+    for (int key : keys) map.erase(key);
+}
+
+CustomMap<int, int> LifecycleManager::remapMap(const CustomMap<int, int>& map, const vector<int>& keyIds,
+                                               const vector<int>& valueIds) {
+    CustomMap<int, int> remapped;
+    remapped.reserve(map.size());
+    for (const auto& pair : map) {
+        if (pair.first < 0 || pair.first >= static_cast<int>(keyIds.size()) || keyIds[pair.first] < 0) continue;
+        if (pair.second < 0 || pair.second >= static_cast<int>(valueIds.size()) || valueIds[pair.second] < 0) continue;
+        remapped.append(keyIds[pair.first], valueIds[pair.second]);
+    }
+    return remapped;
+}
+
+bool LifecycleManager::retireCourse(int id) {
+    if (!cm.removeCourse(id)) return false;
+    rel.removeCourse(id);
+    for (int s = 0; s < pm.getStudentCount(); s++) {
+        auto* student = pm.getStudent(s);
+        if (!student) continue;
+        eraseValue(student->enrolled, id);
+        eraseValue(student->completed, id);
+    }
+    for (int f = 0; f < pm.getFacultyCount(); f++) {
+        auto* fac = pm.getFaculty(f);
+        if (fac) eraseValue(fac->courses, id);
+    }
+    courseToFaculty.erase(id);
+    courseToRoom.erase(id);
+    return true;
+}
+
+bool LifecycleManager::retireStudent(int id) {
+    auto* student = pm.getStudent(id);
+    if (!student) return false;
+    student->enrolled.clear();
+    student->completed.clear();
+    return pm.removeStudent(id);
+}
+
+bool LifecycleManager::retireFaculty(int id) {
+    if (!pm.removeFaculty(id)) return false;
+    eraseByValue(courseToFaculty, id);
+    return true;
+}
+
+bool LifecycleManager::retireRoom(int id) {
+    if (!pm.removeRoom(id)) return false;
+    eraseByValue(courseToRoom, id);
+    return true;
+}
+
+double LifecycleManager::tombstoneRatio() const {
+    int slots = cm.count() + pm.getStudentCount() + pm.getFacultyCount() + pm.getRoomCount();
+    int live = cm.activeCount() + pm.activeStudentCount() + pm.activeFacultyCount() + pm.activeRoomCount();
+    return slots == 0 ? 0.0 : static_cast<double>(slots - live) / slots;
+}
+
+bool LifecycleManager::compactIfNeeded(double threshold) {
+    if (tombstoneRatio() <= threshold) return false;
+    compact();
+    return true;
+}
+
+LifecycleManager::CompactionReport LifecycleManager::compact() {
+    CompactionReport report;
+    report.coursesRemoved = cm.count() - cm.activeCount();
+    report.studentsRemoved = pm.getStudentCount() - pm.activeStudentCount();
+    report.facultyRemoved = pm.getFacultyCount() - pm.activeFacultyCount();
+    report.roomsRemoved = pm.getRoomCount() - pm.activeRoomCount();
+
+    // Every ID space is renumbered from the same snapshot of maps
+    vector<int> courseIds = cm.compactionMap();
+    vector<int> studentIds = pm.studentCompactionMap();
+    vector<int> facultyIds = pm.facultyCompactionMap();
+    vector<int> roomIds = pm.roomCompactionMap();
+
+    cm.compact(courseIds);
+    pm.compact(studentIds, facultyIds, roomIds, courseIds);
+    rel.remap(courseIds);
+    courseToFaculty = remapMap(courseToFaculty, courseIds, facultyIds);
+    courseToRoom = remapMap(courseToRoom, courseIds, roomIds);
+    return report;
 }
 
 // ============================================================================
@@ -192,7 +678,7 @@ void ProofGenerator::generatePrereqProof(int courseId, const vector<bool>& compl
     proofSteps.clear();
     
     const auto* course = cm.getCourse(courseId);
-    string courseName = course ? course->code : to_string(courseId);
+    string courseName = course ? course->code.str() : to_string(courseId);
     
     proofSteps.push_back("Theorem: Can student enroll in " + courseName + "?");
     proofSteps.push_back("Proof by checking prerequisites:");
@@ -204,7 +690,7 @@ void ProofGenerator::generatePrereqProof(int courseId, const vector<bool>& compl
         if (prereq[i][courseId]) {
             hasDirectPrereq = true;
             const auto* p = cm.getCourse(i);
-            string pName = p ? p->code : to_string(i);
+            string pName = p ? p->code.str() : to_string(i);
             
             if (i < static_cast<int>(completed.size()) && completed[i]) {
                 proofSteps.push_back("  - Prerequisite " + pName + " is completed [OK]");
@@ -301,8 +787,8 @@ void ConsistencyChecker::checkEnrollments() {
                     
                     stringstream ss;
                     ss << student->name << " missing prerequisite "
-                       << (p ? p->code : to_string(i)) << " for "
-                       << (c ? c->code : to_string(courseId));
+                       << (p ? p->code.str() : to_string(i)) << " for "
+                       << (c ? c->code.str() : to_string(courseId));
                     errors.push_back(ss.str());
                 }
             }
@@ -319,42 +805,44 @@ void ConsistencyChecker::checkEnrollments() {
 
 void ConsistencyChecker::checkAssignments() {
     for (int i = 0; i < cm.count(); i++) {
+        if (!cm.isActive(i)) continue;
         if (!courseToFaculty.contains(i)) {
             const auto* c = cm.getCourse(i);
             stringstream ss;
-            ss << (c ? c->code : to_string(i)) << " has no faculty assigned";
+            ss << (c ? c->code.str() : to_string(i)) << " has no faculty assigned";
             warnings.push_back(ss.str());
         }
         
         if (!courseToRoom.contains(i)) {
             const auto* c = cm.getCourse(i);
             stringstream ss;
-            ss << (c ? c->code : to_string(i)) << " has no room assigned";
+            ss << (c ? c->code.str() : to_string(i)) << " has no room assigned";
             warnings.push_back(ss.str());
         }
     }
 }
 
 void ConsistencyChecker::checkCapacity() {
+    // Build every course roster in one pass over the students
+    vector<CustomSet<int>> rosters(cm.count());
+    for (int s = 0; s < pm.getStudentCount(); s++) {
+        const auto* student = pm.getStudent(s);
+        if (!student) continue;
+        for (int courseId : student->enrolled) {
+            if (courseId >= 0 && courseId < cm.count()) rosters[courseId].insert(s);
+        }
+    }
+    
     for (const auto& pair : courseToRoom) {
         const auto* r = pm.getRoom(pair.second);
         if (!r) continue;
         
-        int enrolled = 0;
-        for (int s = 0; s < pm.getStudentCount(); s++) {
-            const auto* student = pm.getStudent(s);
-            if (student) {
-                if (find(student->enrolled.begin(), student->enrolled.end(), pair.first)
-                    != student->enrolled.end()) {
-                    enrolled++;
-                }
-            }
-        }
+        int enrolled = (pair.first >= 0 && pair.first < cm.count()) ? rosters[pair.first].size() : 0;
         
         if (enrolled > r->capacity) {
             const auto* c = cm.getCourse(pair.first);
             stringstream ss;
-            ss << (c ? c->code : to_string(pair.first)) << " has " << enrolled
+            ss << (c ? c->code.str() : to_string(pair.first)) << " has " << enrolled
                << " students but room capacity is " << r->capacity;
             errors.push_back(ss.str());
         }
@@ -401,6 +889,8 @@ void PerformanceBenchmark::runAllBenchmarks() {
     benchmarkMapOperations();
     benchmarkRelationsClosure();
     benchmarkFunctionComposition();
+    benchmarkFunctionProperties();
+    benchmarkCourseLookup();
     
     displayResults();
 }
@@ -474,6 +964,79 @@ void PerformanceBenchmark::benchmarkFunctionComposition() {
     results.push_back({"Function Composition", time, "Composing two 100-element functions"});
 }
 
+void PerformanceBenchmark::benchmarkFunctionProperties() {
+    const int n = 1000000;
+    const int advisors = 2000;
+
+    CustomMap<int, int> advisorOf, permutation;
+    advisorOf.reserve(n);
+    permutation.reserve(n);
+    for (int i = 0; i < n; i++) {
+        advisorOf.append(i, i % advisors);
+        permutation.append(i, static_cast<int>((i * 7919LL) % n));
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+    bool injective = Functions::isInjective(advisorOf);
+    bool surjective = Functions::isSurjective(advisorOf, advisors);
+    bool bijective = Functions::isBijective(permutation, n);
+    auto composed = Functions::compose(permutation, advisorOf);
+    auto end = chrono::high_resolution_clock::now();
+    double time = chrono::duration<double, milli>(end - start).count();
+    results.push_back({"Function Props (dense)", time,
+        "1M student->advisor checks + compose" + string(!injective && surjective && bijective &&
+            composed.size() == n ? "" : " [UNEXPECTED]")});
+
+    // Student IDs spread over a wide range force the hashed fallback
+    CustomMap<int, int> sparse;
+    sparse.reserve(n);
+    for (int i = 0; i < n; i++) {
+        sparse.append(i * 2000 - 1000000000, i % advisors);
+    }
+
+    start = chrono::high_resolution_clock::now();
+    injective = Functions::isInjective(sparse);
+    surjective = Functions::isSurjective(sparse, advisors);
+    composed = Functions::compose(permutation, sparse);
+    end = chrono::high_resolution_clock::now();
+    time = chrono::duration<double, milli>(end - start).count();
+    results.push_back({"Function Props (sparse)", time,
+        "1M sparse-key checks + compose" + string(!injective && surjective ? "" : " [UNEXPECTED]")});
+}
+
+void PerformanceBenchmark::benchmarkCourseLookup() {
+    const int courses = 50000;
+    const int lookups = 1000000;
+
+    CourseCodeIndex index;
+    vector<string> codes;
+    for (int i = 0; i < courses; i++) {
+        codes.push_back("C" + to_string(i));
+        index.insert(PooledString(codes.back()), i);
+    }
+
+    long long hits = 0;
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < lookups; i++) hits += index.find(codes[(i * 7919LL) % courses]) >= 0;
+    auto end = chrono::high_resolution_clock::now();
+    results.push_back({"Code Lookup (hashed)", chrono::duration<double, milli>(end - start).count(),
+        "1M lookups over 50k course codes"});
+
+    index.finalize();
+    start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < lookups; i++) hits += index.find(codes[(i * 7919LL) % courses]) >= 0;
+    end = chrono::high_resolution_clock::now();
+    results.push_back({"Code Lookup (perfect)", chrono::duration<double, milli>(end - start).count(),
+        "Same lookups after finalize()" + string(hits == 2LL * lookups ? "" : " [UNEXPECTED]")});
+
+    index.findByPrefix("");
+    start = chrono::high_resolution_clock::now();
+    size_t found = index.findByPrefix("c12").size();
+    end = chrono::high_resolution_clock::now();
+    results.push_back({"Code Prefix Search", chrono::duration<double, milli>(end - start).count(),
+        to_string(found) + " codes matching c12*"});
+}
+
 void PerformanceBenchmark::displayResults() const {
     cout << "\nBenchmark Results:\n";
     cout << left << setw(30) << "Test" << setw(15) << "Time (ms)" << "Description\n";
@@ -515,6 +1078,10 @@ void UnitTesting::runAllTests() {
     testMapOperations();
     testRelations();
     testFunctions();
+    testStringPool();
+    testCourseIndex();
+    testLifecycle();
+    testReportWriter();
     
     displaySummary();
 }
@@ -535,7 +1102,19 @@ void UnitTesting::testSetOperations() {
     
     auto inter = SetOps::setIntersection(a, b);
     assert(inter.size() == 2, "Set intersection size");
-    
+
+    auto diff = SetOps::setDifference(a, b);
+    assert(diff.size() == 1 && diff.contains(1), "Set difference");
+    assert(SetOps::isSubset(inter, a) && !SetOps::isSubset(a, b), "Set subset");
+
+    CustomSet<int> dense, sparse;
+    for (int i = 0; i < 10000; i++) dense.insert(i);
+    for (int i = 0; i < 100000; i += 1000) sparse.insert(i);
+    dense.runOptimize();
+    assert(dense.size() == 10000 && dense.contains(9999) && !dense.contains(10000), "Dense bitmap set");
+    assert(SetOps::intersectionSize(dense, sparse) == 10, "Bitmap intersection cardinality");
+    assert(SetOps::setUnion(dense, sparse).size() == 10090, "Bitmap union size");
+
     cout << "\n";
 }
 
@@ -571,6 +1150,26 @@ void UnitTesting::testRelations() {
     
     assert(!rel.hasPrereqCycle(), "No cycle");
     
+    // Depth is the longest chain, not the prerequisite count: 3 has three
+    // ancestors but sits at depth 2
+    rel.addPrereq(0, 3);
+    rel.addPrereq(1, 3);
+    rel.addPrereq(4, 3);
+    PrereqLayers layers = Induction::layerPrereqs(rel);
+    assert(layers.acyclic() && layers.depth[2] == 2 && layers.depth[3] == 2 && layers.depth[4] == 0,
+           "Longest-path depth per course");
+    assert(layers.ancestorCount[2] == 2 && layers.ancestorCount[3] == 3 && layers.ancestorCount[0] == 0,
+           "Ancestor counts");
+    assert(layers.height() == 3 && layers.layerSize[0] == 2 && layers.layerSize[1] == 1 && layers.layerSize[2] == 2,
+           "Layer histogram");
+    
+    rel.addPrereq(5, 6);
+    rel.addPrereq(6, 5);
+    rel.addPrereq(6, 7);
+    layers = Induction::layerPrereqs(rel);
+    assert(layers.unreached == 3 && layers.depth[7] == -1 && layers.ancestorCount[5] == -1 && layers.depth[3] == 2,
+           "Courses on or behind a cycle get no depth");
+    
     cout << "\n";
 }
 
@@ -585,10 +1184,184 @@ void UnitTesting::testFunctions() {
     assert(Functions::isInjective(f), "Function is injective");
     assert(Functions::isSurjective(f, 3), "Function is surjective");
     assert(Functions::isBijective(f, 3), "Function is bijective");
+
+    CustomMap<int, int> wide;
+    wide.insert(-500000, 7);
+    wide.insert(900000, 7);
+    wide.insert(3, 1000000);
+    assert(!Functions::isInjective(wide) && Functions::isSurjective(wide, 2), "Sparse-key function properties");
+    CustomMap<int, int> g;
+    g.insert(7, 1);
+    g.insert(1000000, 2);
+    CustomMap<int, int> gw = Functions::compose(wide, g);
+    assert(gw.size() == 3 && gw.get(3, -1) == 2 && gw.get(-500000, -1) == 1, "Sparse-value composition");
+    CustomMap<int, int> fInv = Functions::inverse(f, 3);
+    assert(fInv.size() == 3 && Functions::verifyInverse(f, fInv), "Inverse of bijection");
+
+    CustomSet<int> s;
+    s.insert(4);
+    s.insert(7);
+    s.insert(9);
+    vector<CustomSet<int>> ps = Functions::powerSet(s);
+    assert(ps.size() == 8 && ps[0].empty() && ps[7].size() == 3, "Power set size");
+    assert(ps[5].size() == 2 && ps[5].contains(4) && ps[5].contains(9), "Power set mask order");
     
     cout << "\n";
 }
 
+void UnitTesting::testStringPool() {
+    cout << "Testing String Pool:\n";
+
+    StringPool pool;
+    StringPool::Id cs = pool.intern("CS101");
+    StringPool::Id math = pool.intern("MATH201");
+    assert(pool.intern(string("CS") + "101") == cs && pool.size() == 2, "Intern returns existing ID");
+    assert(pool.view(math) == "MATH201" && pool.find("EE100") == StringPool::NONE, "Pool view and find");
+
+    for (int i = 0; i < 5000; i++) pool.intern("STUDENT" + to_string(i));
+    assert(pool.view(cs) == "CS101" && pool.find("STUDENT4999") == 5001, "IDs and views stable across growth");
+
+    stringstream snapshot;
+    pool.write(snapshot);
+    StringPool restored;
+    assert(restored.read(snapshot) && restored.size() == pool.size() && restored.view(math) == "MATH201",
+           "Snapshot round trip keeps IDs");
+
+    CourseManager cm;
+    cm.addCourse("POOL101", "Pooled Course", 3);
+    PooledString code("POOL101");
+    assert(cm.getCourse(0)->code == code && cm.getCourseByCode("POOL101") == 0, "Course code interned");
+
+    cout << "\n";
+}
+
+void UnitTesting::testCourseIndex() {
+    cout << "Testing Course Code Index:\n";
+
+    CourseCodeIndex index;
+    for (int i = 0; i < 300; i++) {
+        string dept = (i % 3 == 0) ? "CS" : (i % 3 == 1) ? "MATH" : "ELECTRICAL-ENG";
+        index.insert(PooledString(dept + to_string(100 + i)), i);
+    }
+    assert(!index.insert(PooledString("CS100"), 999) && index.size() == 300, "Duplicate code rejected");
+    assert(index.find("CS100") == 0 && index.find("ELECTRICAL-ENG102") == 2 && index.find("CS101") == -1,
+           "Hashed exact lookup");
+
+    assert(index.finalize() && index.isPerfect(), "Minimal perfect hash built");
+    assert(index.find("MATH101") == 1 && index.find("ELECTRICAL-ENG399") == 299 && index.find("PHY101") == -1,
+           "Perfect hash lookup");
+
+    assert(index.findIgnoreCase("math104") == 4, "Case-insensitive lookup");
+    vector<int> cs2 = index.findByPrefix("cs2");
+    assert(cs2.size() == 33 && cs2.front() == 102 && cs2.back() == 198, "Prefix lookup");
+
+    index.insert(PooledString("cs250x"), 500);
+    assert(!index.isPerfect() && index.find("cs250x") == 500 && index.findByPrefix("CS2").size() == 34,
+           "Insert after finalize");
+
+    cout << "\n";
+}
+
+void UnitTesting::testLifecycle() {
+    cout << "Testing Entity Lifecycle:\n";
+
+    CourseManager cm;
+    PeopleManager pm;
+    Relations rel;
+    CustomMap<int, int> courseToFaculty, courseToRoom;
+    for (int i = 0; i < 4; i++) cm.addCourse("LC" + to_string(i), "Lifecycle " + to_string(i), 3);
+    rel.addPrereq(0, 1);
+    rel.addPrereq(1, 2);
+    rel.addPrereq(2, 3);
+    pm.addStudent("A");
+    pm.addStudent("B");
+    pm.addFaculty("F0");
+    pm.addFaculty("F1");
+    pm.addRoom("R0", 30);
+    pm.getStudent(0)->enrolled = {1, 3};
+    pm.getStudent(1)->enrolled = {2};
+    courseToFaculty.insert(1, 0);
+    courseToFaculty.insert(3, 1);
+    courseToRoom.insert(3, 0);
+
+    LifecycleManager lifecycle(cm, pm, rel, courseToFaculty, courseToRoom);
+    assert(lifecycle.retireCourse(1) && !lifecycle.retireCourse(1), "Course retired once");
+    assert(!cm.getCourse(1) && cm.getCourseByCode("LC1") == -1 && cm.activeCount() == 3, "Retired course hidden");
+    assert(!rel.getPrereq(0, 1) && !rel.getPrereq(1, 2) && rel.getPrereq(2, 3), "Prereq edges scrubbed");
+    assert(pm.getStudent(0)->enrolled.size() == 1 && !courseToFaculty.contains(1), "References scrubbed");
+
+    assert(cm.addCourse("LC9", "Recycled", 3) == 1 && cm.getCourseByCode("LC9") == 1, "Course ID recycled");
+
+    assert(lifecycle.retireCourse(0) && lifecycle.retireStudent(0) && lifecycle.retireFaculty(0), "Retire mixed entities");
+    LifecycleManager::CompactionReport report = lifecycle.compact();
+    assert(report.coursesRemoved == 1 && report.studentsRemoved == 1 && report.facultyRemoved == 1,
+           "Compaction report");
+    assert(cm.count() == 4 - 1 && pm.getStudentCount() == 1 && pm.getFacultyCount() == 1, "Tombstones dropped");
+    int lc2 = cm.getCourseByCode("LC2"), lc3 = cm.getCourseByCode("LC3");
+    assert(lc2 == 1 && lc3 == 2 && rel.getPrereq(lc2, lc3), "Relations remapped");
+    assert(pm.getStudent(0)->enrolled.size() == 1 && pm.getStudent(0)->enrolled[0] == lc2, "Enrollments remapped");
+    assert(courseToFaculty.get(lc3, -1) == 0 && courseToRoom.get(lc3, -1) == 0, "Assignment maps remapped");
+
+    cout << "\n";
+}
+
+void UnitTesting::testReportWriter() {
+    cout << "Testing Report Writer:\n";
+
+    ostringstream fields;
+    {
+        ReportWriter w(fields);
+        w.left("ab", 5).put('|').right("ab", 5).put('|').left(42, 4).put('|').right(-7, 4).put('|');
+        w.left("toolongfield", 4).put('|').right("toolongfield", 4);
+    }
+    assert(fields.str() == "ab   |   ab|42  |  -7|toolongfield|toolongfield", "Padding and long fields");
+
+    ostringstream numbers;
+    {
+        ReportWriter w(numbers);
+        w.number(0).put(' ').number(LLONG_MIN).put(' ').number(LLONG_MAX).put(' ').number(-1);
+    }
+    assert(numbers.str() == "0 " + to_string(LLONG_MIN) + " " + to_string(LLONG_MAX) + " -1", "Number formatting");
+
+    ostringstream grown;
+    string big(1000, 'x');
+    {
+        ReportWriter w(grown, 256);
+        w.text("start ").text(big).repeat('-', 600).text(" end");
+    }
+    assert(grown.str() == "start " + big + string(600, '-') + " end", "Field larger than buffer");
+
+    CourseManager cm;
+    for (int i = 0; i < 3; i++) cm.addCourse("RW" + to_string(i), "Report " + to_string(i), 3);
+    ostringstream page, pastEnd, whole;
+    streambuf* saved = cout.rdbuf(page.rdbuf());
+    cm.listAll(1, 1);
+    cout.rdbuf(pastEnd.rdbuf());
+    cm.listAll(5, 2);
+    cout.rdbuf(whole.rdbuf());
+    cm.listAll();
+    cout.rdbuf(saved);
+    assert(page.str().find("Showing 2-2 of 3\n") != string::npos && page.str().find("RW2") == string::npos,
+           "Paging footer");
+    assert(pastEnd.str().find("Showing 0 of 3\n") != string::npos, "Paging past the end");
+    assert(whole.str().find("Showing") == string::npos, "No footer when every row shown");
+
+    CourseManager chain;
+    Relations rel;
+    int n = DisplayHelper::DENSE_MATRIX_LIMIT + 5;
+    for (int i = 0; i < n; i++) chain.addCourse("SP" + to_string(i), "Sparse " + to_string(i), 3);
+    for (int i = 0; i + 1 < n; i++) rel.addPrereq(i, i + 1);
+    ostringstream sparse;
+    saved = cout.rdbuf(sparse.rdbuf());
+    DisplayHelper::displayMatrix(rel, chain);
+    cout.rdbuf(saved);
+    assert(sparse.str().find("SP1          requires: SP0\n") != string::npos &&
+           sparse.str().find(to_string(n) + " courses, " + to_string(n - 1) + " prerequisite pairs (sparse view)") != string::npos,
+           "Sparse matrix view");
+
+    cout << "\n";
+}
+
 void UnitTesting::displaySummary() const {
     cout << string(60, '=') << "\n";
     cout << "Test Summary:\n";
@@ -630,29 +1403,48 @@ void DisplayHelper::printInfo(const string& msg) {
     cout << "[INFO] " << msg << "\n";
 }
 
+// Up to DENSE_MATRIX_LIMIT courses print as a Y/. grid; wider relations
+// list each course's prerequisites, skipping courses with none
 void DisplayHelper::displayMatrix(const Relations& rel, const CourseManager& cm) {
-    cout << "\n" << string(60, '=') << "\n";
-    cout << "  PREREQUISITE MATRIX\n";
-    cout << string(60, '=') << "\n\n";
+    ReportWriter w;
+    w.newline().repeat('=', 60).newline().text("  PREREQUISITE MATRIX").newline().repeat('=', 60).newline().newline();
     
     int size = rel.getSize();
-    cout << "   ";
+    const auto& matrix = rel.getPrereqMatrix();
+    vector<string> labels(size);
     for (int i = 0; i < size; i++) {
         const auto* c = cm.getCourse(i);
-        cout << setw(6) << (c ? c->code : to_string(i));
+        labels[i] = c ? c->code.str() : to_string(i);
     }
-    cout << "\n";
     
-    auto matrix = rel.getPrereqMatrix();
-    for (int i = 0; i < size; i++) {
-        const auto* c = cm.getCourse(i);
-        cout << setw(3) << (c ? c->code : to_string(i));
-        for (int j = 0; j < size; j++) {
-            cout << setw(6) << (matrix[i][j] ? "Y" : ".");
+    if (size <= DENSE_MATRIX_LIMIT) {
+        w.text("   ");
+        for (int i = 0; i < size; i++) w.right(labels[i], 6);
+        w.newline();
+        for (int i = 0; i < size; i++) {
+            w.right(labels[i], 3);
+            for (int j = 0; j < size; j++) w.right(matrix[i][j] ? "Y" : ".", 6);
+            w.newline();
         }
-        cout << "\n";
+        w.newline();
+        return;
     }
-    cout << "\n";
+    
+    long long edges = 0;
+    for (int j = 0; j < size; j++) {
+        bool any = false;
+        for (int i = 0; i < size; i++) {
+            if (!matrix[i][j]) continue;
+            if (!any) {
+                w.left(labels[j], 12).text(" requires:");
+                any = true;
+            }
+            w.put(' ').text(labels[i]);
+            edges++;
+        }
+        if (any) w.newline();
+    }
+    w.newline().number(size).text(" courses, ").number(edges).text(" prerequisite pairs (sparse view)").newline().newline();
 }
 
 void DisplayHelper::displayFunctionAnalysis(const CustomMap<int, int>& f, const CourseManager& cm,
@@ -666,8 +1458,8 @@ void DisplayHelper::displayFunctionAnalysis(const CustomMap<int, int>& f, const
     for (const auto& pair : f) {
         const auto* c = cm.getCourse(pair.first);
         auto* fac = pm.getFaculty(pair.second);
-        cout << "  " << (c ? c->code : to_string(pair.first)) << " -> "
-             << (fac ? fac->name : to_string(pair.second)) << "\n";
+        cout << "  " << (c ? c->code.str() : to_string(pair.first)) << " -> "
+             << (fac ? fac->name.str() : to_string(pair.second)) << "\n";
     }
     cout << "\n";
 }
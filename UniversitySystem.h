@@ -2,10 +2,60 @@
 #define UNIVERSITY_SYSTEM_H
 
 #include "DiscreteStructures.h"
+#include "ReportWriter.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <iostream>
 
+// ============================================================================
+// COURSE CODE INDEX
+// ============================================================================
+// Exact lookups go through an open-addressed table that stores each code's
+// hash; codes of up to 8 bytes are also packed into one word and compared
+// as integers. finalize() can rebuild the table as a minimal perfect hash
+// (hash-and-displace) after a bulk load. Case-insensitive and prefix queries
+// use a sorted table of upper-cased codes, rebuilt lazily after inserts.
+
+class CourseCodeIndex {
+private:
+    struct Slot {
+        size_t hash;
+        unsigned long long packed;
+        int length;
+        int courseId;
+        PooledString code;
+    };
+
+    std::vector<Slot> table;
+    int entries;
+    std::vector<Slot> perfectSlots;
+    std::vector<unsigned int> displacement;
+    bool perfect;
+    mutable std::vector<std::pair<std::string, int>> folded;
+    mutable bool foldedValid;
+
+    static unsigned long long pack(const std::string& code);
+    static unsigned long long mix(unsigned long long h, unsigned int seed);
+    static size_t reduce(unsigned long long h, size_t n);
+    static bool matches(const Slot& s, size_t hash, unsigned long long packed, const std::string& code);
+    void grow();
+    void buildFolded() const;
+
+public:
+    CourseCodeIndex();
+    bool insert(const PooledString& code, int courseId);
+    bool erase(const std::string& code);
+    int find(const std::string& code) const;
+    int findIgnoreCase(const std::string& code) const;
+    std::vector<int> findByPrefix(const std::string& prefix) const;
+    bool finalize();
+    bool isPerfect() const;
+    int size() const;
+    void clear();
+    static std::string fold(const std::string& s);
+};
+
 // ============================================================================
 // COURSE MANAGER
 // ============================================================================
@@ -14,8 +64,8 @@ class CourseManager {
 public:
     struct Course {
         int id;
-        std::string code;
-        std::string name;
+        PooledString code;
+        PooledString name;
         int credits;
         bool active;
         Course();
@@ -24,15 +74,28 @@ public:
 
 private:
     std::vector<Course> courses;
-    CustomMap<std::string, int> codeToId;
+    CourseCodeIndex codeToId;
+    std::vector<int> freeIds;
 
 public:
+    // IDs stay below count(). Removed courses are tombstones (getCourse
+    // returns nullptr) whose IDs are reused by addCourse; compact() renumbers
+    // the survivors densely. LifecycleManager keeps other references in step.
     int addCourse(const std::string& code, const std::string& name, int credits);
+    bool removeCourse(int id);
+    bool isActive(int id) const;
+    int activeCount() const;
+    std::vector<int> compactionMap() const;
+    void compact(const std::vector<int>& newIds);
     const Course* getCourse(int id) const;
     Course* getCourse(int id);
     int getCourseByCode(const std::string& code) const;
+    int getCourseByCodeIgnoreCase(const std::string& code) const;
+    std::vector<int> findCoursesByPrefix(const std::string& prefix) const;
+    bool finalizeCodeIndex();
     int count() const;
-    void listAll() const;
+    // Prints active courses firstRow.. (maxRows < 0: to the end)
+    void listAll(int firstRow = 0, int maxRows = -1) const;
     const std::vector<Course>& getAllCourses() const;
 };
 
@@ -44,26 +107,29 @@ class PeopleManager {
 public:
     struct Student {
         int id;
-        std::string name;
+        PooledString name;
         std::vector<int> enrolled;
         std::vector<int> completed;
+        bool active;
         Student();
         Student(int i, std::string n);
     };
 
     struct Faculty {
         int id;
-        std::string name;
+        PooledString name;
         std::vector<int> courses;
+        bool active;
         Faculty();
         Faculty(int i, std::string n);
     };
 
     struct Room {
         int id;
-        std::string name;
-        std::string roomNumber;
+        PooledString name;
+        PooledString roomNumber;
         int capacity;
+        bool active;
         Room();
         Room(int i, std::string n, int cap = 30);
     };
@@ -72,11 +138,26 @@ private:
     std::vector<Student> students;
     std::vector<Faculty> faculties;
     std::vector<Room> rooms;
+    std::vector<int> freeStudentIds;
+    std::vector<int> freeFacultyIds;
+    std::vector<int> freeRoomIds;
 
 public:
+    // Same tombstone/free-list scheme as CourseManager
     int addStudent(const std::string& name);
     int addFaculty(const std::string& name);
     int addRoom(const std::string& name, int capacity = 30);
+    bool removeStudent(int id);
+    bool removeFaculty(int id);
+    bool removeRoom(int id);
+    int activeStudentCount() const;
+    int activeFacultyCount() const;
+    int activeRoomCount() const;
+    std::vector<int> studentCompactionMap() const;
+    std::vector<int> facultyCompactionMap() const;
+    std::vector<int> roomCompactionMap() const;
+    void compact(const std::vector<int>& studentIds, const std::vector<int>& facultyIds,
+                 const std::vector<int>& roomIds, const std::vector<int>& courseIds);
 
     Student* getStudent(int id);
     Faculty* getFaculty(int id);
@@ -90,11 +171,52 @@ public:
     int getFacultyCount() const;
     int getRoomCount() const;
 
-    void listAllStudents() const;
+    // Prints active students firstRow.. (maxRows < 0: to the end)
+    void listAllStudents(int firstRow = 0, int maxRows = -1) const;
     void listAllFaculties() const;
     void listAllRooms() const;
 };
 
+// ============================================================================
+// ENTITY LIFECYCLE - Retirement and compaction
+// ============================================================================
+// Retiring an entity tombstones it and drops every reference to it (prereq
+// edges, enrollments, faculty loads, course-faculty/room maps), so its ID can
+// be reused safely. compact() renumbers all four ID spaces in one pass.
+
+class LifecycleManager {
+public:
+    struct CompactionReport {
+        int coursesRemoved;
+        int studentsRemoved;
+        int facultyRemoved;
+        int roomsRemoved;
+    };
+
+private:
+    CourseManager& cm;
+    PeopleManager& pm;
+    Relations& rel;
+    CustomMap<int, int>& courseToFaculty;
+    CustomMap<int, int>& courseToRoom;
+
+    static void eraseValue(std::vector<int>& list, int value);
+    static void eraseByValue(CustomMap<int, int>& map, int value);
+    static CustomMap<int, int> remapMap(const CustomMap<int, int>& map, const std::vector<int>& keyIds,
+                                        const std::vector<int>& valueIds);
+
+public:
+    LifecycleManager(CourseManager& c, PeopleManager& p, Relations& r,
+                     CustomMap<int, int>& cf, CustomMap<int, int>& cr);
+    bool retireCourse(int id);
+    bool retireStudent(int id);
+    bool retireFaculty(int id);
+    bool retireRoom(int id);
+    double tombstoneRatio() const;
+    bool compactIfNeeded(double threshold = 0.25);
+    CompactionReport compact();
+};
+
 // ============================================================================
 // PROOF GENERATOR
 // ============================================================================
@@ -159,6 +281,8 @@ public:
     void benchmarkMapOperations();
     void benchmarkRelationsClosure();
     void benchmarkFunctionComposition();
+    void benchmarkFunctionProperties();
+    void benchmarkCourseLookup();
     void displayResults() const;
 };
 
@@ -180,15 +304,21 @@ public:
     void testMapOperations();
     void testRelations();
     void testFunctions();
+    void testStringPool();
+    void testCourseIndex();
+    void testLifecycle();
+    void testReportWriter();
     void displaySummary() const;
 };
 
 // ============================================================================
 // DISPLAY UTILITIES
 // ============================================================================
-
 class DisplayHelper {
 public:
+    // Matrices wider than this print as prerequisite lists instead of a grid
+    static const int DENSE_MATRIX_LIMIT = 40;
+
     static void printHeader(const std::string& title);
     static void printSuccess(const std::string& msg);
     static void printError(const std::string& msg);
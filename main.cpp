@@ -1,6 +1,7 @@
 #include "UniversitySystem.h"
 #include <iostream>
 #include <string>
+#include <iomanip>
 
 using namespace std;
 
@@ -89,6 +90,8 @@ void showMainMenu() {
     cout << "16. Relations Analysis\n";
     cout << "\nUTILITIES:\n";
     cout << "17. Quick Setup\n";
+    cout << "18. Retire Course/Student/Faculty/Room\n";
+    cout << "19. Compact Storage\n";
     cout << "\n 0. Exit\n";
     cout << "\nChoice: ";
 }
@@ -167,7 +170,7 @@ int main() {
             cin >> from;
             cout << "For Course ID: ";
             cin >> to;
-            if (from >= 0 && from < cm.count() && to >= 0 && to < cm.count()) {
+            if (cm.isActive(from) && cm.isActive(to)) {
                 rel.addPrereq(from, to);
                 cout << "[SUCCESS] Prerequisite added\n";
             } else {
@@ -182,7 +185,7 @@ int main() {
             cin >> courseId;
             cout << "Faculty ID: ";
             cin >> facultyId;
-            if (courseId >= 0 && courseId < cm.count() && facultyId >= 0 && facultyId < pm.getFacultyCount()) {
+            if (cm.isActive(courseId) && pm.getFaculty(facultyId)) {
                 courseToFaculty.insert(courseId, facultyId);
                 auto* fac = pm.getFaculty(facultyId);
                 if (fac) fac->courses.push_back(courseId);
@@ -199,7 +202,7 @@ int main() {
             cin >> courseId;
             cout << "Room ID: ";
             cin >> roomId;
-            if (courseId >= 0 && courseId < cm.count() && roomId >= 0 && roomId < pm.getRoomCount()) {
+            if (cm.isActive(courseId) && pm.getRoom(roomId)) {
                 courseToRoom.insert(courseId, roomId);
                 cout << "[SUCCESS] Room assigned\n";
             } else {
@@ -215,7 +218,7 @@ int main() {
             cout << "Course ID: ";
             cin >> courseId;
             auto* student = pm.getStudent(studentId);
-            if (student && courseId >= 0 && courseId < cm.count()) {
+            if (student && cm.isActive(courseId)) {
                 student->enrolled.push_back(courseId);
                 cout << "[SUCCESS] Student enrolled\n";
             } else {
@@ -249,7 +252,7 @@ int main() {
                 int c;
                 cout << "Course ID: ";
                 cin >> c;
-                if (c >= 0 && c < cm.count()) {
+                if (cm.isActive(c)) {
                     vector<bool> completed(cm.count(), false);
                     cout << "Enter completed course IDs (-1 to stop): ";
                     int x;
@@ -282,10 +285,10 @@ int main() {
         case 14: {
             DisplayHelper::printHeader("SYSTEM STATISTICS");
             cout << "\nCurrent System Status:\n";
-            cout << "  Total Courses:  " << cm.count() << "\n";
-            cout << "  Total Students: " << pm.getStudentCount() << "\n";
-            cout << "  Total Faculty:  " << pm.getFacultyCount() << "\n";
-            cout << "  Total Rooms:    " << pm.getRoomCount() << "\n";
+            cout << "  Total Courses:  " << cm.activeCount() << "\n";
+            cout << "  Total Students: " << pm.activeStudentCount() << "\n";
+            cout << "  Total Faculty:  " << pm.activeFacultyCount() << "\n";
+            cout << "  Total Rooms:    " << pm.activeRoomCount() << "\n";
             
             int totalPrereqs = 0;
             for (int i = 0; i < rel.getSize(); i++) {
@@ -306,7 +309,7 @@ int main() {
         }
         
         case 16: {
-            cout << "\n1. Display Matrix\n2. Check Properties\n3. Transitive Closure\nChoice: ";
+            cout << "\n1. Display Matrix\n2. Check Properties\n3. Transitive Closure\n4. Depth Layers\nChoice: ";
             int sub;
             cin >> sub;
             if (sub == 1) {
@@ -328,6 +331,22 @@ int main() {
                     cout << "\n";
                 }
                 cout << "\n";
+            } else if (sub == 4) {
+                DisplayHelper::printHeader("PREREQUISITE DEPTH LAYERS");
+                PrereqLayers layers = Induction::layerPrereqs(rel);
+                Induction::provePrereqDepth(rel, layers.height());
+                cout << "\nDepth  Courses\n";
+                for (int d = 0; d < layers.height(); d++) {
+                    cout << setw(5) << d << "  " << layers.layerSize[d] << "\n";
+                }
+                cout << "\nCourse        Depth  Ancestors\n";
+                for (int c = 0; c < rel.getSize(); c++) {
+                    const auto* course = cm.getCourse(c);
+                    if (!course) continue;
+                    cout << left << setw(12) << course->code.str() << right << setw(7) << layers.depth[c]
+                         << setw(11) << layers.ancestorCount[c] << "\n";
+                }
+                cout << "\n";
             }
             break;
         }
@@ -336,6 +355,37 @@ int main() {
             quickSetup(cm, pm, rel, courseToFaculty, courseToRoom);
             break;
         
+        case 18: {
+            cout << "\n1. Course\n2. Student\n3. Faculty\n4. Room\nChoice: ";
+            int sub, id;
+            cin >> sub;
+            cout << "ID: ";
+            cin >> id;
+            LifecycleManager lifecycle(cm, pm, rel, courseToFaculty, courseToRoom);
+            bool retired = (sub == 1) ? lifecycle.retireCourse(id)
+                         : (sub == 2) ? lifecycle.retireStudent(id)
+                         : (sub == 3) ? lifecycle.retireFaculty(id)
+                         : (sub == 4) ? lifecycle.retireRoom(id) : false;
+            if (retired) {
+                DisplayHelper::printSuccess("Entity retired");
+                if (lifecycle.compactIfNeeded()) {
+                    DisplayHelper::printInfo("Storage compacted - IDs were renumbered");
+                }
+            } else {
+                DisplayHelper::printError("Invalid or already retired ID");
+            }
+            break;
+        }
+        
+        case 19: {
+            LifecycleManager lifecycle(cm, pm, rel, courseToFaculty, courseToRoom);
+            auto report = lifecycle.compact();
+            DisplayHelper::printSuccess("Compaction complete");
+            cout << "  Removed " << report.coursesRemoved << " courses, " << report.studentsRemoved
+                 << " students, " << report.facultyRemoved << " faculty, " << report.roomsRemoved << " rooms\n";
+            break;
+        }
+        
         default:
             DisplayHelper::printError("Invalid choice!");
         }